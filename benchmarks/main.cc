@@ -0,0 +1,338 @@
+#include <cstdlib>   // EXIT_SUCCESS, EXIT_FAILURE
+#include <cstdio>    // std::remove
+#include <iostream>  // std::cout, std::cerr
+#include <iomanip>   // std::setw, std::setprecision
+#include <string>    // std::string
+#include <vector>    // std::vector
+#include <chrono>    // std::chrono::steady_clock
+#include <algorithm> // std::sort
+
+#include <SDL2/SDL.h>
+
+#include "../src/utils.hh"
+#include "../src/units.hh"
+#include "../src/file.hh"
+#include "../src/ini.hh"
+#include "../src/timer.hh"
+#include "../src/manager.hh"
+#include "../src/texture.hh"
+#include "../src/sheet.hh"
+#include "../src/draw_list.hh"
+#include "../src/text/font.hh"
+#include "../src/text/text_renderer.hh"
+#include "../src/world/world.hh"
+
+// Every sample runs the benchmark for at least this long, the iteration count is picked to match
+#define BENCH_SAMPLE_NS 20000000
+#define BENCH_SAMPLES   9
+
+#define BENCH_INI_PATH    "bench.ini"
+#define BENCH_INI_ENTRIES 500
+
+#define BENCH_TIMERS 10000
+
+using namespace CityBuilder;
+
+// Results are written here so the compiler can not throw the benchmarked code away
+static volatile float g_sink;
+
+static uint64_t Now() {
+	auto elapsed = std::chrono::steady_clock::now().time_since_epoch();
+
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+}
+
+static std::string g_filter;
+
+// p_func(iterations) runs the operation that many times. Reports the median and the fastest of
+// the samples in nanoseconds per operation, the median is what should be compared between runs
+template<typename Func>
+static void Bench(const std::string &p_name, Func &&p_func) {
+	if (not g_filter.empty() and p_name.find(g_filter) == std::string::npos)
+		return;
+
+	// Warm up and find how many iterations fill a sample
+	size_t iterations = 1;
+	for (;;) {
+		uint64_t start = Now();
+		p_func(iterations);
+
+		if (Now() - start >= BENCH_SAMPLE_NS)
+			break;
+
+		iterations *= 2;
+	}
+
+	std::vector<double> samples;
+	for (size_t i = 0; i < BENCH_SAMPLES; ++ i) {
+		uint64_t start = Now();
+		p_func(iterations);
+
+		samples.push_back(static_cast<double>(Now() - start) / iterations);
+	}
+
+	std::sort(samples.begin(), samples.end());
+
+	std::cout << std::left  << std::setw(32) << p_name << std::right << std::fixed
+	          << std::setprecision(2)
+	          << std::setw(12) << samples[samples.size() / 2] << " ns/op"
+	          << std::setw(12) << samples.front()             << " ns/op min"
+	          << std::setw(12) << iterations                  << " iterations" << std::endl;
+}
+
+static void BenchUnits() {
+	Bench("Vec2f arithmetic", [](size_t p_n) {
+		Vec2f a(1.5f, 2.5f), b(0.25f, 0.5f);
+		for (size_t i = 0; i < p_n; ++ i)
+			a = (a + b) * Vec2f(0.5f) - b / Vec2f(2);
+
+		g_sink = a.x + a.y;
+	});
+
+	Bench("Rectf Round/Ceil", [](size_t p_n) {
+		Rectf rect(0.3f, 0.6f, 10.4f, 20.7f);
+		float sum = 0;
+		for (size_t i = 0; i < p_n; ++ i) {
+			rect.x += 0.1f;
+			sum    += rect.Round().x + rect.Ceil().w;
+		}
+
+		g_sink = sum;
+	});
+
+	Bench("Rectf Touches(Vec2i)", [](size_t p_n) {
+		Rectf rect(10, 10, 100, 50);
+		size_t hits = 0;
+		for (size_t i = 0; i < p_n; ++ i)
+			hits += rect.Touches(Vec2i(i % 128, i % 64));
+
+		g_sink = hits;
+	});
+}
+
+static void BenchWorld() {
+	World world(Vec2i(64));
+	world.camera.zoom = 0.75f;
+
+	Bench("Projection::TileRect (64x64 tiles)", [&world](size_t p_n) {
+		float sum = 0;
+		for (size_t i = 0; i < p_n; ++ i) {
+			Projection projection(world.camera);
+
+			for (int y = 0; y < world.size.y; ++ y) {
+				for (int x = 0; x < world.size.x; ++ x)
+					sum += projection.TileRect(x, y).x;
+			}
+		}
+
+		g_sink = sum;
+	});
+
+	std::vector<Recti> rects(world.size.x);
+
+	Bench("Projection::RowRects (64x64 tiles)", [&](size_t p_n) {
+		float sum = 0;
+		for (size_t i = 0; i < p_n; ++ i) {
+			Projection projection(world.camera);
+
+			for (int y = 0; y < world.size.y; ++ y) {
+				projection.RowRects(0, y, rects.size(), rects.data());
+				sum += rects[0].x;
+			}
+		}
+
+		g_sink = sum;
+	});
+
+	World big(Vec2i(512));
+	big.camera.zoom = ZOOM_MIN;
+
+	// Moving, so the visible tiles get copied into the snapshot every tick
+	Bench("World::Tick snapshot (512x512 tiles)", [&big](size_t p_n) {
+		for (size_t i = 0; i < p_n; ++ i) {
+			big.camera.pos.x = static_cast<float>(i % 64 * TILE_W);
+			big.Tick();
+		}
+
+		g_sink = big.Front().version;
+	});
+
+	// Alternating, so every fill changes the whole world
+	Bench("World FillRect + Undo (512x512 tiles)", [&big](size_t p_n) {
+		for (size_t i = 0; i < p_n; ++ i) {
+			big.Apply(Command::FillRect(Vec2i(0), Vec2i(511), i % 2? Tile::Sand : Tile::Water));
+			big.Apply(Command::Undo());
+			big.ClearDirtyChunks();
+		}
+
+		g_sink = big.DirtyChunks().size();
+	});
+
+	Bench("World FloodFill (512x512 tiles)", [&big](size_t p_n) {
+		for (size_t i = 0; i < p_n; ++ i) {
+			big.Apply(Command::FloodFill(Vec2i(0), i % 2? Tile::Sand : Tile::Water));
+			big.ClearDirtyChunks();
+		}
+
+		g_sink = big.DirtyChunks().size();
+	});
+}
+
+static void BenchSheet(Texture &p_texture) {
+	Sheet sheet(TILE_SIZE, &p_texture);
+
+	Bench("Sheet::Source", [&sheet](size_t p_n) {
+		float sum = 0;
+		for (size_t i = 0; i < p_n; ++ i)
+			sum += sheet.Source(i % 2).x;
+
+		g_sink = sum;
+	});
+}
+
+static void BenchText(Texture &p_texture) {
+	Text::Font font(6, 9, Color4i(255, 0, 255));
+	font.SetSheet(p_texture);
+
+	Text::Renderer renderer;
+	DrawList       drawList;
+
+	const std::string text = "Update v1.0.0 - Some basic 10x10 flat grass world";
+
+	Bench("Text::Renderer::Draw hit", [&](size_t p_n) {
+		for (size_t i = 0; i < p_n; ++ i) {
+			renderer.Draw(drawList, text, font, Vec2f(10, 10), 1, Color4i(255));
+			drawList.Clear();
+		}
+	});
+
+	Bench("Text::Renderer::Draw miss", [&](size_t p_n) {
+		for (size_t i = 0; i < p_n; ++ i) {
+			renderer.ClearCache();
+			renderer.Draw(drawList, text, font, Vec2f(10, 10), 1, Color4i(255));
+			drawList.Clear();
+		}
+	});
+}
+
+static void BenchINI() {
+	std::string src = "[general]\n";
+	for (size_t i = 0; i < BENCH_INI_ENTRIES; ++ i) {
+		if (i % 50 == 0)
+			src += "[section" + std::to_string(i / 50) + "]\n";
+
+		src += "key" + std::to_string(i) + " = value " + std::to_string(i * 7) + "\n";
+	}
+
+	auto err = WriteFile(BENCH_INI_PATH, src);
+	if (not err.Ok())
+		Panic(err);
+
+	Bench("INI::ParseFile (500 entries)", [](size_t p_n) {
+		for (size_t i = 0; i < p_n; ++ i) {
+			INI ini;
+
+			auto err = ini.ParseFile(BENCH_INI_PATH);
+			if (not err.Ok())
+				Panic(err);
+		}
+	});
+
+	std::remove(BENCH_INI_PATH);
+}
+
+static void BenchTimers() {
+	TimerWheel timers;
+
+	size_t ended = 0, *endedPtr = &ended;
+
+	// Spread out enough to cascade through the levels, like construction and growth timers would
+	for (size_t i = 0; i < BENCH_TIMERS; ++ i)
+		timers.Schedule(1 + i * 37 % 100000, [endedPtr]() {++ *endedPtr;});
+
+	Bench("TimerWheel::Update (10000 timers)", [&](size_t p_n) {
+		for (size_t i = 0; i < p_n; ++ i) {
+			timers.Update();
+
+			// Keep the count steady
+			while (timers.Count() < BENCH_TIMERS)
+				timers.Schedule(1 + i * 37 % 100000, [endedPtr]() {++ *endedPtr;});
+		}
+	});
+
+	Bench("TimerWheel::Schedule + Cancel", [&](size_t p_n) {
+		for (size_t i = 0; i < p_n; ++ i)
+			timers.Cancel(timers.Schedule(1 + i % 5000, [endedPtr]() {++ *endedPtr;}));
+	});
+
+	g_sink = ended;
+}
+
+class IntManager : public Manager<int, std::string> {
+public:
+	Handle Add(const std::string &p_key, int p_val) {
+		return _Add(p_key, std::move(p_val));
+	}
+};
+
+static void BenchManager() {
+	IntManager manager;
+
+	std::vector<std::string>        keys;
+	std::vector<IntManager::Handle> handles;
+	for (int i = 0; i < 64; ++ i) {
+		keys.push_back("textures/key" + std::to_string(i));
+		handles.push_back(manager.Add(keys.back(), i));
+	}
+
+	Bench("Manager::Get(Handle)", [&](size_t p_n) {
+		int sum = 0;
+		for (size_t i = 0; i < p_n; ++ i)
+			sum += manager.Get(handles[i % handles.size()]);
+
+		g_sink = sum;
+	});
+
+	Bench("Manager::Get(string_view)", [&](size_t p_n) {
+		int sum = 0;
+		for (size_t i = 0; i < p_n; ++ i)
+			sum += manager.Get(std::string_view(keys[i % keys.size()]));
+
+		g_sink = sum;
+	});
+}
+
+int main(int p_argc, char **p_argv) {
+	if (p_argc > 1)
+		g_filter = p_argv[1];
+
+	// A software renderer on a surface is enough for textures, no window or video driver needed
+	SDL_Surface  *surface  = SDL_CreateRGBSurfaceWithFormat(0, 256, 256, 32, SDL_PIXELFORMAT_RGBA32);
+	SDL_Renderer *renderer = surface == nullptr? nullptr : SDL_CreateSoftwareRenderer(surface);
+	SDL_Texture  *page     = renderer == nullptr? nullptr :
+	                         SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+	                                           SDL_TEXTUREACCESS_STATIC, 256, 256);
+	if (page == nullptr) {
+		std::cerr << "SDL2 Error: " << SDL_GetError() << std::endl;
+
+		return EXIT_FAILURE;
+	}
+
+	{
+		Texture texture(page, Recti(0, 0, 128, 64));
+
+		BenchUnits();
+		BenchWorld();
+		BenchSheet(texture);
+		BenchText(texture);
+		BenchINI();
+		BenchTimers();
+		BenchManager();
+	}
+
+	SDL_DestroyTexture(page);
+	SDL_DestroyRenderer(renderer);
+	SDL_FreeSurface(surface);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,62 @@
+#include "arena.hh"
+
+namespace CityBuilder {
+
+FrameArena::FrameArena(Memory::Tag p_tag, size_t p_blockSize):
+	m_tag(p_tag),
+	m_blockSize(p_blockSize),
+
+	m_block(0),
+	m_used(0)
+{}
+
+FrameArena::~FrameArena() {
+	Memory::Freed(m_tag, Capacity());
+}
+
+void *FrameArena::Alloc(size_t p_size, size_t p_align) {
+	while (m_block < m_blocks.size()) {
+		Block &block = m_blocks[m_block];
+
+		std::uintptr_t base  = reinterpret_cast<uintptr_t>(block.data.get());
+		size_t         start = (base + m_used + p_align - 1) / p_align * p_align - base;
+
+		if (start + p_size <= block.size) {
+			m_used = start + p_size;
+
+			return block.data.get() + start;
+		}
+
+		// The rest of this block is wasted until the next Reset()
+		++ m_block;
+		m_used = 0;
+	}
+
+	// Oversized allocations get a block of their own
+	Block block;
+	block.size = std::max(m_blockSize, p_size + p_align);
+	block.data = std::make_unique<uint8_t[]>(block.size);
+
+	Memory::Allocated(m_tag, block.size);
+
+	m_blocks.push_back(std::move(block));
+	m_block = m_blocks.size() - 1;
+	m_used  = 0;
+
+	return Alloc(p_size, p_align);
+}
+
+void FrameArena::Reset() {
+	m_block = 0;
+	m_used  = 0;
+}
+
+size_t FrameArena::Capacity() const {
+	size_t capacity = 0;
+	for (const auto &block : m_blocks)
+		capacity += block.size;
+
+	return capacity;
+}
+
+}
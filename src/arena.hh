@@ -0,0 +1,62 @@
+#ifndef ARENA_HH__HEADER_GUARD__
+#define ARENA_HH__HEADER_GUARD__
+
+#include <vector>      // std::vector
+#include <memory>      // std::unique_ptr, std::make_unique
+#include <algorithm>   // std::max
+#include <cstdint>     // std::uintptr_t
+#include <new>         // placement new
+#include <utility>     // std::forward
+#include <type_traits> // std::is_trivially_destructible
+
+#include "utils.hh"
+#include "memory.hh"
+
+#define ARENA_BLOCK_SIZE 4096
+
+namespace CityBuilder {
+
+// Bump allocator for data that lives for a single frame. Reset() rewinds it without giving the
+// memory back, so after the first few frames nothing gets allocated anymore. Destructors are
+// never run, so only trivially destructible types can be made in it
+class FrameArena {
+public:
+	// The blocks are counted as p_tag memory
+	FrameArena(Memory::Tag p_tag, size_t p_blockSize = ARENA_BLOCK_SIZE);
+
+	FrameArena(FrameArena &&p_arena)      = default;
+	FrameArena(const FrameArena &p_arena) = delete;
+
+	~FrameArena();
+
+	void *Alloc(size_t p_size, size_t p_align);
+
+	template<typename T, typename... Args>
+	T *New(Args&&... p_args) {
+		static_assert(std::is_trivially_destructible<T>::value,
+		              "FrameArena never runs destructors");
+
+		return new (Alloc(sizeof(T), alignof(T))) T(std::forward<Args>(p_args)...);
+	}
+
+	void Reset();
+
+	// Bytes held by all blocks
+	size_t Capacity() const;
+
+private:
+	struct Block {
+		std::unique_ptr<uint8_t[]> data;
+		size_t                     size;
+	};
+
+	Memory::Tag m_tag;
+	size_t      m_blockSize;
+
+	std::vector<Block> m_blocks;
+	size_t             m_block, m_used;
+};
+
+}
+
+#endif
@@ -0,0 +1,88 @@
+#include "atlas.hh"
+
+namespace CityBuilder {
+
+SkylinePacker::SkylinePacker(const Vec2i &p_size):
+	m_size(p_size)
+{
+	m_skyline.push_back({0, 0, p_size.x});
+}
+
+Maybe<Vec2i> SkylinePacker::Insert(const Vec2i &p_size) {
+	size_t  bestIdx = m_skyline.size();
+	int32_t bestY   = m_size.y, bestW = m_size.x;
+
+	for (size_t i = 0; i < m_skyline.size(); ++ i) {
+		Maybe<int32_t> y = Fits(i, p_size);
+		if (y.none)
+			continue;
+
+		if (y.unwrap < bestY or
+		    (y.unwrap == bestY and m_skyline[i].w < bestW)) {
+			bestIdx = i;
+			bestY   = y.unwrap;
+			bestW   = m_skyline[i].w;
+		}
+	}
+
+	if (bestIdx == m_skyline.size())
+		return Maybe<Vec2i>::None();
+
+	Vec2i pos(m_skyline[bestIdx].x, bestY);
+
+	m_skyline.insert(m_skyline.begin() + bestIdx, {pos.x, pos.y + p_size.y, p_size.x});
+
+	// Cut the segments now hidden under the new one
+	for (size_t i = bestIdx + 1; i < m_skyline.size();) {
+		Segment &prev = m_skyline[i - 1];
+		Segment &seg  = m_skyline[i];
+
+		if (seg.x >= prev.x + prev.w)
+			break;
+
+		int32_t shrink = prev.x + prev.w - seg.x;
+		seg.x += shrink;
+		seg.w -= shrink;
+
+		if (seg.w > 0)
+			break;
+
+		m_skyline.erase(m_skyline.begin() + i);
+	}
+
+	// Merge neighbours at the same height
+	for (size_t i = 0; i + 1 < m_skyline.size();) {
+		if (m_skyline[i].y == m_skyline[i + 1].y) {
+			m_skyline[i].w += m_skyline[i + 1].w;
+			m_skyline.erase(m_skyline.begin() + i + 1);
+		} else
+			++ i;
+	}
+
+	return pos;
+}
+
+Vec2i SkylinePacker::Size() const {
+	return m_size;
+}
+
+Maybe<int32_t> SkylinePacker::Fits(size_t p_idx, const Vec2i &p_size) const {
+	if (m_skyline[p_idx].x + p_size.x > m_size.x)
+		return Maybe<int32_t>::None();
+
+	int32_t y = m_skyline[p_idx].y, widthLeft = p_size.x;
+	for (size_t i = p_idx; widthLeft > 0; ++ i) {
+		if (i >= m_skyline.size())
+			return Maybe<int32_t>::None();
+
+		y = std::max(y, m_skyline[i].y);
+		if (y + p_size.y > m_size.y)
+			return Maybe<int32_t>::None();
+
+		widthLeft -= m_skyline[i].w;
+	}
+
+	return y;
+}
+
+}
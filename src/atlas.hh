@@ -0,0 +1,43 @@
+#ifndef ATLAS_HH__HEADER_GUARD__
+#define ATLAS_HH__HEADER_GUARD__
+
+#include <vector>    // std::vector
+#include <algorithm> // std::max
+
+#include "utils.hh"
+#include "units.hh"
+
+#define ATLAS_PAGE_W    1024
+#define ATLAS_PAGE_H    1024
+#define ATLAS_PAGE_SIZE Vec2i(ATLAS_PAGE_W, ATLAS_PAGE_H)
+
+// Empty pixels kept between packed images so scaled draws dont bleed into the neighbours
+#define ATLAS_PADDING 1
+
+namespace CityBuilder {
+
+// Bottom-left skyline rectangle packer. The skyline is the top edge of everything packed so far,
+// stored as horizontal segments sorted by x. A new rectangle goes where its top ends up lowest.
+class SkylinePacker {
+public:
+	SkylinePacker(const Vec2i &p_size);
+
+	Maybe<Vec2i> Insert(const Vec2i &p_size);
+
+	Vec2i Size() const;
+
+private:
+	struct Segment {
+		int32_t x, y, w;
+	};
+
+	Maybe<int32_t> Fits(size_t p_idx, const Vec2i &p_size) const;
+
+	Vec2i m_size;
+
+	std::vector<Segment> m_skyline;
+};
+
+}
+
+#endif
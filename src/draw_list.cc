@@ -0,0 +1,213 @@
+#include "draw_list.hh"
+
+namespace CityBuilder {
+
+DrawList::Stats::Stats():
+	commands(0),
+	batches(0),
+	textureSwitches(0)
+{}
+
+DrawList::DrawList() {
+	Clear();
+}
+
+void DrawList::SetClip(const Recti &p_clip) {
+	Recti &last = m_clips.back();
+	if (last.x == p_clip.x and last.y == p_clip.y and last.w == p_clip.w and last.h == p_clip.h)
+		m_clip = m_clips.size() - 1;
+	else {
+		m_clips.push_back(p_clip);
+		m_clip = m_clips.size() - 1;
+	}
+}
+
+void DrawList::ResetClip() {
+	m_clip = 0;
+}
+
+void DrawList::Quad(const Texture &p_texture, const Rectf &p_src, const Rectf &p_dest,
+                    const Color4i &p_color) {
+	Vec2f raw = p_texture.RawSize();
+	Vec2f uv0 = (p_src.Pos() + static_cast<Vec2f>(p_texture.region.Pos())) / raw;
+	Vec2f uv1 = uv0 + p_src.Size() / raw;
+
+	SDL_Vertex *quad  = AddQuads(p_texture.raw, 1, p_dest);
+	SDL_Color   color = p_color;
+
+	quad[0] = {{p_dest.x,            p_dest.y},            color, {uv0.x, uv0.y}};
+	quad[1] = {{p_dest.x + p_dest.w, p_dest.y},            color, {uv1.x, uv0.y}};
+	quad[2] = {{p_dest.x + p_dest.w, p_dest.y + p_dest.h}, color, {uv1.x, uv1.y}};
+	quad[3] = {{p_dest.x,            p_dest.y + p_dest.h}, color, {uv0.x, uv1.y}};
+}
+
+void DrawList::Fill(const Rectf &p_dest, const Color4i &p_color) {
+	SDL_Vertex *quad  = AddQuads(nullptr, 1, p_dest);
+	SDL_Color   color = p_color;
+
+	quad[0] = {{p_dest.x,            p_dest.y},            color, {0, 0}};
+	quad[1] = {{p_dest.x + p_dest.w, p_dest.y},            color, {0, 0}};
+	quad[2] = {{p_dest.x + p_dest.w, p_dest.y + p_dest.h}, color, {0, 0}};
+	quad[3] = {{p_dest.x,            p_dest.y + p_dest.h}, color, {0, 0}};
+}
+
+SDL_Vertex *DrawList::AddQuads(SDL_Texture *p_texture, size_t p_count, const Rectf &p_bounds) {
+	Command command;
+	command.texture = p_texture;
+	command.clip    = m_clip;
+	command.bounds  = p_bounds;
+	command.first   = m_vertices.size() / 4;
+	command.count   = p_count;
+	command.next    = m_commands.size();
+
+	// What is outside of the clip rect cant overlap anything
+	if (m_clip != 0) {
+		SDL_Rect a = m_clips[m_clip], b = p_bounds.Floor(), bounds;
+		b.w += 1;
+		b.h += 1;
+
+		if (SDL_IntersectRect(&a, &b, &bounds))
+			command.bounds = bounds;
+		else
+			command.bounds = Rectf();
+	}
+
+	m_commands.push_back(command);
+	m_vertices.resize(m_vertices.size() + p_count * 4);
+
+	return &m_vertices[command.first * 4];
+}
+
+void DrawList::Submit(RenderContext &p_context) {
+	PROFILE_ZONE("DrawList::Submit");
+
+	Build();
+
+	m_stats.commands        = m_commands.size();
+	m_stats.batches         = m_batches.size();
+	m_stats.textureSwitches = 0;
+
+	size_t       clip    = 0;
+	SDL_Texture *texture = nullptr;
+	for (auto &batch : m_batches) {
+		if (batch.texture != texture) {
+			texture = batch.texture;
+
+			++ m_stats.textureSwitches;
+		}
+
+		if (batch.clip != clip) {
+			clip = batch.clip;
+
+			if (clip == 0)
+				p_context.SetClip(nullptr);
+			else {
+				SDL_Rect rect = m_clips[clip];
+				p_context.SetClip(&rect);
+			}
+		}
+
+		m_batchVertices.clear();
+		for (size_t idx = batch.head; idx < m_commands.size(); idx = m_commands[idx].next) {
+			const Command &command = m_commands[idx];
+
+			m_batchVertices.insert(m_batchVertices.end(),
+			                       m_vertices.begin() + command.first * 4,
+			                       m_vertices.begin() + (command.first + command.count) * 4);
+		}
+
+		// Every quad is the same two triangles, so the indices only ever grow
+		size_t quads = m_batchVertices.size() / 4;
+		for (size_t i = m_indices.size() / 6; i < quads; ++ i) {
+			int base = static_cast<int>(i * 4);
+
+			for (int idx : {0, 1, 2, 2, 3, 0})
+				m_indices.push_back(base + idx);
+		}
+
+		p_context.Geometry(batch.texture,
+		                   m_batchVertices.data(), static_cast<int>(m_batchVertices.size()),
+		                   m_indices.data(), static_cast<int>(quads * 6));
+	}
+
+	if (clip != 0)
+		p_context.SetClip(nullptr);
+
+	Clear();
+}
+
+void DrawList::Clear() {
+	m_vertices.clear();
+	m_commands.clear();
+	m_batches.clear();
+
+	// Clip 0 is no clip at all
+	m_clips.clear();
+	m_clips.push_back(Recti(0, 0, -1, -1));
+
+	m_clip = 0;
+}
+
+const DrawList::Stats &DrawList::GetStats() const {
+	return m_stats;
+}
+
+bool DrawList::Overlap(const Rectf &p_a, const Rectf &p_b) {
+	return p_a.x < p_b.x + p_b.w and p_b.x < p_a.x + p_a.w and
+	       p_a.y < p_b.y + p_b.h and p_b.y < p_a.y + p_a.h;
+}
+
+Rectf DrawList::Union(const Rectf &p_a, const Rectf &p_b) {
+	if (p_a.w <= 0 or p_a.h <= 0)
+		return p_b;
+	else if (p_b.w <= 0 or p_b.h <= 0)
+		return p_a;
+
+	float x = std::min(p_a.x, p_b.x);
+	float y = std::min(p_a.y, p_b.y);
+
+	return Rectf(x, y, std::max(p_a.x + p_a.w, p_b.x + p_b.w) - x,
+	                   std::max(p_a.y + p_a.h, p_b.y + p_b.h) - y);
+}
+
+void DrawList::Build() {
+	for (size_t i = 0; i < m_commands.size(); ++ i) {
+		Command &command = m_commands[i];
+		command.next     = m_commands.size();
+
+		Maybe<size_t> target;
+		for (size_t j = m_batches.size(), steps = 0; j -- > 0 and steps < DRAW_LIST_LOOKBACK;
+		     ++ steps) {
+			const Batch &batch = m_batches[j];
+
+			if (batch.texture == command.texture and batch.clip == command.clip) {
+				target = j;
+
+				break;
+			}
+
+			// Has to stay on top of this batch
+			if (Overlap(batch.bounds, command.bounds))
+				break;
+		}
+
+		if (target.none) {
+			Batch batch;
+			batch.texture = command.texture;
+			batch.clip    = command.clip;
+			batch.bounds  = command.bounds;
+			batch.head    = i;
+			batch.tail    = i;
+
+			m_batches.push_back(batch);
+		} else {
+			Batch &batch = m_batches[target.unwrap];
+			batch.bounds = Union(batch.bounds, command.bounds);
+
+			m_commands[batch.tail].next = i;
+			batch.tail                  = i;
+		}
+	}
+}
+
+}
@@ -0,0 +1,89 @@
+#ifndef DRAW_LIST_HH__HEADER_GUARD__
+#define DRAW_LIST_HH__HEADER_GUARD__
+
+#include <vector>    // std::vector
+#include <algorithm> // std::min, std::max
+
+#include <SDL2/SDL.h>
+
+#include "utils.hh"
+#include "units.hh"
+#include "texture.hh"
+#include "render_context.hh"
+#include "memory.hh"
+#include "profiler.hh"
+
+// How many batches back a command may be moved to join a batch with the same texture and clip
+#define DRAW_LIST_LOOKBACK 16
+
+namespace CityBuilder {
+
+// Records textured and colored quads for a frame and submits them in as few draw calls as
+// possible. Commands are merged into an earlier batch with the same texture and clip rect as long
+// as they dont overlap anything drawn in between, so the result looks the same as drawing in
+// order. Anything drawn straight through the render context on top of recorded commands needs a
+// Submit() first.
+class DrawList {
+public:
+	struct Stats {
+		Stats();
+
+		size_t commands, batches, textureSwitches;
+	};
+
+	DrawList();
+
+	void SetClip(const Recti &p_clip);
+	void ResetClip();
+
+	// p_src is relative to the texture region, like in Texture::Render
+	void Quad(const Texture &p_texture, const Rectf &p_src, const Rectf &p_dest,
+	          const Color4i &p_color = Color4i(255));
+	void Fill(const Rectf &p_dest, const Color4i &p_color);
+
+	// Space for p_count quads (4 vertices each, clockwise from top left) drawn from p_texture.
+	// p_bounds has to cover all of them. The pointer is valid until the next command
+	SDL_Vertex *AddQuads(SDL_Texture *p_texture, size_t p_count, const Rectf &p_bounds);
+
+	void Submit(RenderContext &p_context);
+	void Clear();
+
+	// Of the last Submit()
+	const Stats &GetStats() const;
+
+private:
+	struct Command {
+		SDL_Texture *texture;
+		size_t       clip;
+		Rectf        bounds;
+
+		size_t first, count; // Quads
+		size_t next;         // The next command in the same batch
+	};
+
+	struct Batch {
+		SDL_Texture *texture;
+		size_t       clip;
+		Rectf        bounds;
+
+		size_t head, tail; // Commands
+	};
+
+	static bool  Overlap(const Rectf &p_a, const Rectf &p_b);
+	static Rectf Union(const Rectf &p_a, const Rectf &p_b);
+
+	void Build();
+
+	TrackedVector<SDL_Vertex, Memory::DrawList> m_vertices, m_batchVertices;
+	TrackedVector<int,        Memory::DrawList> m_indices;
+	TrackedVector<Command,    Memory::DrawList> m_commands;
+	TrackedVector<Batch,      Memory::DrawList> m_batches;
+	TrackedVector<Recti,      Memory::DrawList> m_clips;
+
+	size_t m_clip;
+	Stats  m_stats;
+};
+
+}
+
+#endif
@@ -0,0 +1,274 @@
+#include "file.hh"
+
+#include <sys/stat.h> // stat
+#include <cstdio>     // std::rename, std::remove
+
+#ifdef CITY_BUILDER_POSIX
+#	include <sys/mman.h> // mmap, munmap
+#	include <fcntl.h>    // open, O_RDONLY
+#	include <unistd.h>   // close, read, write, fsync
+#endif
+
+namespace CityBuilder {
+
+ErrorOr<MappedFile> MappedFile::Open(const std::string &p_path) {
+	MappedFile file;
+
+#ifdef CITY_BUILDER_POSIX
+	int fd = open(p_path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return ErrorOr<MappedFile>::Make("Failed to open file '", p_path, "'");
+
+	struct stat info;
+	if (fstat(fd, &info) != 0) {
+		close(fd);
+
+		return ErrorOr<MappedFile>::Make("Failed to stat file '", p_path, "'");
+	}
+
+	file.m_size = static_cast<size_t>(info.st_size);
+
+	// Empty files cant be mapped, an empty view is fine for them
+	if (file.m_size > 0) {
+		void *data = mmap(nullptr, file.m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED) {
+			close(fd);
+
+			return ErrorOr<MappedFile>::Make("Failed to map file '", p_path, "'");
+		}
+
+		file.m_data   = static_cast<const char*>(data);
+		file.m_mapped = true;
+	}
+
+	close(fd);
+#else
+	auto content = ReadFile(p_path);
+	if (not content.Ok())
+		return ErrorOr<MappedFile>::Make(content.Desc());
+
+	file.m_fallback = std::move(content.Value());
+	file.m_size     = file.m_fallback.size();
+#endif
+
+	return ErrorOr<MappedFile>::Fine(std::move(file));
+}
+
+MappedFile::MappedFile():
+	m_data(nullptr),
+	m_size(0),
+	m_mapped(false)
+{}
+
+MappedFile::MappedFile(MappedFile &&p_file):
+	m_data(p_file.m_data),
+	m_size(p_file.m_size),
+	m_mapped(p_file.m_mapped),
+
+	m_fallback(std::move(p_file.m_fallback))
+{
+	p_file.m_data   = nullptr;
+	p_file.m_size   = 0;
+	p_file.m_mapped = false;
+}
+
+MappedFile::~MappedFile() {
+	Free();
+}
+
+MappedFile &MappedFile::operator =(MappedFile &&p_file) {
+	if (this == &p_file)
+		return *this;
+
+	Free();
+
+	m_data     = p_file.m_data;
+	m_size     = p_file.m_size;
+	m_mapped   = p_file.m_mapped;
+	m_fallback = std::move(p_file.m_fallback);
+
+	p_file.m_data   = nullptr;
+	p_file.m_size   = 0;
+	p_file.m_mapped = false;
+
+	return *this;
+}
+
+void MappedFile::Free() {
+#ifdef CITY_BUILDER_POSIX
+	if (m_mapped)
+		munmap(const_cast<char*>(m_data), m_size);
+#endif
+
+	m_data   = nullptr;
+	m_size   = 0;
+	m_mapped = false;
+
+	m_fallback.clear();
+}
+
+std::string_view MappedFile::View() const {
+	if (m_mapped)
+		return std::string_view(m_data, m_size);
+	else
+		return std::string_view(m_fallback.data(), m_fallback.size());
+}
+
+size_t MappedFile::Size() const {
+	return m_size;
+}
+
+ErrorOr<FileReader> FileReader::Open(const std::string &p_path, size_t p_chunkSize) {
+	if (p_chunkSize == 0)
+		Panic("FileReader: Chunk size is 0");
+
+	std::ifstream stream(p_path, std::ios::binary);
+	if (not stream.is_open())
+		return ErrorOr<FileReader>::Make("Failed to open file '", p_path, "'");
+
+	return ErrorOr<FileReader>::Fine(FileReader(std::move(stream), p_chunkSize));
+}
+
+FileReader::FileReader(std::ifstream &&p_stream, size_t p_chunkSize):
+	m_stream(std::move(p_stream)),
+	m_chunk(p_chunkSize)
+{}
+
+ErrorOr<std::string_view> FileReader::Next() {
+	if (End())
+		return ErrorOr<std::string_view>::Fine(std::string_view());
+
+	m_stream.read(m_chunk.data(), m_chunk.size());
+	if (m_stream.bad())
+		return ErrorOr<std::string_view>::Make("Failed to read file chunk");
+
+	return ErrorOr<std::string_view>::Fine(std::string_view(m_chunk.data(),
+	                                                        static_cast<size_t>(m_stream.gcount())));
+}
+
+bool FileReader::End() const {
+	return m_stream.eof() or not m_stream.good();
+}
+
+ErrorOr<std::string> ReadFile(const std::string &p_path) {
+	std::string content;
+
+#ifdef CITY_BUILDER_POSIX
+	int fd = open(p_path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return ErrorOr<std::string>::Make("Failed to open file '", p_path, "'");
+
+	struct stat info;
+	if (fstat(fd, &info) != 0) {
+		close(fd);
+
+		return ErrorOr<std::string>::Make("Failed to stat file '", p_path, "'");
+	}
+
+	content.resize(static_cast<size_t>(info.st_size));
+
+	// read() may return less than asked for, so keep going until the whole size is in
+	for (size_t done = 0; done < content.size();) {
+		ssize_t ret = read(fd, content.data() + done, content.size() - done);
+		if (ret <= 0) {
+			close(fd);
+
+			return ErrorOr<std::string>::Make("Failed to read file '", p_path, "'");
+		}
+
+		done += static_cast<size_t>(ret);
+	}
+
+	close(fd);
+#else
+	std::ifstream file(p_path, std::ios::binary | std::ios::ate);
+	if (not file.is_open())
+		return ErrorOr<std::string>::Make("Failed to open file '", p_path, "'");
+
+	content.resize(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+
+	if (not file.read(content.data(), content.size()))
+		return ErrorOr<std::string>::Make("Failed to read file '", p_path, "'");
+#endif
+
+	return ErrorOr<std::string>::Fine(std::move(content));
+}
+
+Error WriteFile(const std::string &p_path, std::string_view p_content) {
+	std::string temp = p_path + FILE_TEMP_SUFFIX;
+
+#ifdef CITY_BUILDER_POSIX
+	int fd = open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd == -1)
+		return Error::Make("Failed to open file '", temp, "'");
+
+	for (size_t done = 0; done < p_content.size();) {
+		ssize_t ret = write(fd, p_content.data() + done, p_content.size() - done);
+		if (ret <= 0) {
+			close(fd);
+			std::remove(temp.c_str());
+
+			return Error::Make("Failed to write file '", temp, "'");
+		}
+
+		done += static_cast<size_t>(ret);
+	}
+
+	if (fsync(fd) != 0) {
+		close(fd);
+		std::remove(temp.c_str());
+
+		return Error::Make("Failed to flush file '", temp, "'");
+	}
+
+	close(fd);
+#else
+	{
+		std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+		if (not file.is_open())
+			return Error::Make("Failed to open file '", temp, "'");
+
+		file.write(p_content.data(), p_content.size());
+		if (not file.good()) {
+			file.close();
+			std::remove(temp.c_str());
+
+			return Error::Make("Failed to write file '", temp, "'");
+		}
+	}
+
+	// rename() does not replace existing files on every platform
+	std::remove(p_path.c_str());
+#endif
+
+	if (std::rename(temp.c_str(), p_path.c_str()) != 0) {
+		std::remove(temp.c_str());
+
+		return Error::Make("Failed to rename '", temp, "' to '", p_path, "'");
+	}
+
+	return Error::Fine();
+}
+
+Maybe<FileStamp> StatFile(const std::string &p_path) {
+	struct stat info;
+	if (stat(p_path.c_str(), &info) != 0)
+		return Maybe<FileStamp>::None();
+
+	FileStamp stamp;
+	stamp.size = static_cast<uint64_t>(info.st_size);
+
+#if defined(__APPLE__)
+	stamp.mtime = static_cast<int64_t>(info.st_mtimespec.tv_sec) * 1000000000 +
+	              info.st_mtimespec.tv_nsec;
+#elif defined(CITY_BUILDER_POSIX)
+	stamp.mtime = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+#else
+	stamp.mtime = static_cast<int64_t>(info.st_mtime) * 1000000000;
+#endif
+
+	return stamp;
+}
+
+}
@@ -0,0 +1,90 @@
+#ifndef FILE_HH__HEADER_GUARD__
+#define FILE_HH__HEADER_GUARD__
+
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <cstdint>     // std::int64_t, std::uint64_t
+#include <fstream>     // std::ifstream
+#include <vector>      // std::vector
+
+#include "utils.hh"
+
+#if defined(__unix__) or defined(__APPLE__)
+#	define CITY_BUILDER_POSIX
+#endif
+
+#define FILE_READER_CHUNK_SIZE (64 * 1024)
+#define FILE_TEMP_SUFFIX       ".tmp"
+
+namespace CityBuilder {
+
+// Read-only view of a whole file. It is memory-mapped where the platform supports it, otherwise
+// the file is read into an owned buffer with a single read
+class MappedFile {
+public:
+	[[nodiscard]]
+	static ErrorOr<MappedFile> Open(const std::string &p_path);
+
+	MappedFile();
+	MappedFile(MappedFile &&p_file);
+	MappedFile(const MappedFile &p_file) = delete;
+
+	~MappedFile();
+
+	MappedFile &operator =(MappedFile &&p_file);
+
+	void Free();
+
+	std::string_view View() const;
+	size_t           Size() const;
+
+private:
+	const char *m_data;
+	size_t      m_size;
+	bool        m_mapped;
+
+	std::string m_fallback;
+};
+
+// Streams a file in fixed-size chunks, for inputs too large to hold in memory at once
+class FileReader {
+public:
+	[[nodiscard]]
+	static ErrorOr<FileReader> Open(const std::string &p_path,
+	                                size_t p_chunkSize = FILE_READER_CHUNK_SIZE);
+
+	FileReader(FileReader &&p_reader) = default;
+	FileReader(const FileReader &p_reader) = delete;
+
+	// The returned view is valid until the next call, an empty view means end of file
+	ErrorOr<std::string_view> Next();
+
+	bool End() const;
+
+private:
+	FileReader(std::ifstream &&p_stream, size_t p_chunkSize);
+
+	std::ifstream     m_stream;
+	std::vector<char> m_chunk;
+};
+
+// Reads the whole file with a single sized read, the content is kept byte for byte
+[[nodiscard]]
+ErrorOr<std::string> ReadFile(const std::string &p_path);
+
+// Writes into a temporary file next to p_path and renames it over p_path, so readers never see
+// a half written file
+Error WriteFile(const std::string &p_path, std::string_view p_content);
+
+// Tells whether a file changed. The size catches edits within the timestamp resolution
+struct FileStamp {
+	int64_t  mtime; // Nanoseconds, where the platform has them
+	uint64_t size;
+};
+
+// None if the file does not exist
+Maybe<FileStamp> StatFile(const std::string &p_path);
+
+}
+
+#endif
@@ -2,14 +2,144 @@
 
 namespace CityBuilder {
 
-Error INI::ParseFile(const std::string &p_path) {
-	std::ifstream file(p_path);
-	if (not file.is_open())
-		return Error::Make("Failed to open file '" + p_path + "'");
+static std::string_view TrimView(std::string_view p_str) {
+	size_t start = p_str.find_first_not_of(" \t\v");
+	if (start == std::string_view::npos)
+		return std::string_view();
+
+	size_t end = p_str.find_last_not_of(" \t\v");
+
+	return p_str.substr(start, end + 1 - start);
+}
+
+static ErrorOr<std::string> Unescape(std::string_view p_str) {
+	std::string unescaped;
+	unescaped.reserve(p_str.length());
+
+	bool escape = false;
+	for (size_t i = 0; i < p_str.length(); ++ i) {
+		char ch = p_str[i];
+
+		if (not escape) {
+			if (ch == '\\')
+				escape = true;
+			else
+				unescaped += ch;
 
-	std::string line, section;
-	for (size_t lineNum = 1; std::getline(file, line); ++ lineNum) {
-		if (line.empty())
+			continue;
+		}
+
+		escape = false;
+
+		switch (ch) {
+		case 'n':  unescaped += '\n';   break;
+		case 'r':  unescaped += '\r';   break;
+		case 't':  unescaped += '\t';   break;
+		case 'f':  unescaped += '\f';   break;
+		case 'b':  unescaped += '\b';   break;
+		case 'a':  unescaped += '\a';   break;
+		case 'e':  unescaped += '\x1b'; break;
+		case '"':  unescaped += '"';    break;
+		case '=':  unescaped += '=';    break;
+		case '\\': unescaped += '\\';   break;
+
+		default:
+			return ErrorOr<std::string>::Make("Unknown escape sequence '\\", ch,
+			                                  "' at char ", i + 1);
+		}
+	}
+
+	return ErrorOr<std::string>::Fine(unescaped);
+}
+
+static Maybe<bool> ParseBool(std::string_view p_str) {
+	if (p_str == "true" or p_str == "1")
+		return true;
+	else if (p_str == "false" or p_str == "0")
+		return false;
+	else
+		return Maybe<bool>::None();
+}
+
+template<typename T>
+static Maybe<T> ParseNumber(std::string_view p_str) {
+	T    value;
+	auto end = p_str.data() + p_str.size();
+	auto ret = std::from_chars(p_str.data(), end, value);
+
+	if (ret.ec != std::errc() or ret.ptr != end)
+		return Maybe<T>::None();
+
+	return value;
+}
+
+static bool EntryLess(const INIView::Entry &p_a, const INIView::Entry &p_b) {
+	if (p_a.section != p_b.section)
+		return p_a.section < p_b.section;
+	else
+		return p_a.key < p_b.key;
+}
+
+Error INIView::ParseFile(const std::string &p_path, const std::string &p_cachePath) {
+	Clear();
+
+	Maybe<FileStamp> stamp = StatFile(p_path);
+	if (stamp.none)
+		return Error::Make("Failed to open file '", p_path, "'");
+
+	if (not p_cachePath.empty() and LoadCache(p_cachePath, stamp.unwrap))
+		return Error::Fine();
+
+	auto file = MappedFile::Open(p_path);
+	if (not file.Ok())
+		return Error::Make(file.Desc());
+
+	m_file = std::move(file.Value());
+
+	auto err = ParseSource(m_file.View());
+	if (not err.Ok()) {
+		Clear();
+
+		return err;
+	}
+
+	if (not p_cachePath.empty()) {
+		err = WriteCache(p_cachePath, stamp.unwrap);
+#ifdef CITY_BUILDER_LOG
+		if (not err.Ok())
+			Log("INI: ", err.Desc());
+#endif
+	}
+
+	return Error::Fine();
+}
+
+Error INIView::Parse(std::string_view p_src) {
+	Clear();
+
+	auto err = ParseSource(p_src);
+	if (not err.Ok())
+		Clear();
+
+	return err;
+}
+
+Error INIView::ParseSource(std::string_view p_src) {
+	std::string_view section;
+
+	size_t lineNum = 1;
+	for (size_t pos = 0; pos < p_src.length(); ++ lineNum) {
+		size_t end = p_src.find('\n', pos);
+		if (end == std::string_view::npos)
+			end = p_src.length();
+
+		std::string_view line = p_src.substr(pos, end - pos);
+		pos = end + 1;
+
+		if (not line.empty() and line.back() == '\r')
+			line.remove_suffix(1);
+
+		if (TrimView(line).empty())
 			continue;
 
 		switch (line.at(0)) {
@@ -17,58 +147,261 @@ Error INI::ParseFile(const std::string &p_path) {
 
 		case '[':
 			{
-				size_t end = line.find_first_of(']');
-
-				if (end == std::string::npos)
+				size_t close = line.find(']');
+				if (close == std::string_view::npos)
 					return Error::Make("Missing ']' at line ", lineNum);
 
-				section = line.substr(1, end - 1);
+				section = line.substr(1, close - 1);
 			}
 
 			break;
 
 		default:
 			{
-				size_t assignIdx = 0;
-				while (true) {
-					assignIdx = line.find_first_of('=', assignIdx + 1);
+				size_t assignIdx = line.find('=');
+				while (assignIdx != std::string_view::npos and assignIdx > 0 and
+				       line[assignIdx - 1] == '\\')
+					assignIdx = line.find('=', assignIdx + 1);
 
-					if (assignIdx == std::string::npos)
-						return Error::Make("Missing '=' at line ", lineNum);
+				if (assignIdx == std::string_view::npos)
+					return Error::Make("Missing '=' at line ", lineNum);
 
-					if (assignIdx > 0) {
-						if (line.at(assignIdx - 1) != '\\')
-							break;
-					}
-				}
+				Entry entry;
+				entry.section = section;
 
-				auto ret = Unescape(Trim(line.substr(0, assignIdx)));
-				if (not ret.Ok())
-					return Error::Make(ret.Desc(), ", at line ", lineNum);
+				auto err = Store(TrimView(line.substr(0, assignIdx)), entry.key);
+				if (not err.Ok())
+					return Error::Make(err.Desc(), ", at line ", lineNum);
 
-				std::string key = ret.Value();
-				if (key.empty())
+				if (entry.key.empty())
 					return Error::Make("Empty key at line ", lineNum);
 
-				ret = Unescape(Trim(line.substr(assignIdx + 1)));
-				if (not ret.Ok())
-					return Error::Make(ret.Desc(), ", at line ", lineNum);
+				err = Store(TrimView(line.substr(assignIdx + 1)), entry.value);
+				if (not err.Ok())
+					return Error::Make(err.Desc(), ", at line ", lineNum);
 
-				std::string value = ret.Value();
-
-				m_sections[section][key] = value;
+				m_entries.push_back(entry);
 			}
 		}
 	}
 
+	std::stable_sort(m_entries.begin(), m_entries.end(), EntryLess);
+
+	// Later assignments of the same key override the earlier ones
+	size_t count = 0;
+	for (size_t i = 0; i < m_entries.size(); ++ i) {
+		if (i + 1 < m_entries.size() and not EntryLess(m_entries[i], m_entries[i + 1]))
+			continue;
+
+		m_entries[count ++] = m_entries[i];
+	}
+
+	m_entries.resize(count);
+
 	return Error::Fine();
 }
 
-bool INI::Has(const std::string &p_key, const std::string &p_section) {
-	if (m_sections.count(p_section) == 0)
+Error INIView::Store(std::string_view p_str, std::string_view &p_stored) {
+	if (p_str.find('\\') == std::string_view::npos) {
+		p_stored = p_str;
+
+		return Error::Fine();
+	}
+
+	auto ret = Unescape(p_str);
+	if (not ret.Ok())
+		return Error::Make(ret.Desc());
+
+	m_unescaped.push_back(std::move(ret.Value()));
+	p_stored = m_unescaped.back();
+
+	return Error::Fine();
+}
+
+bool INIView::Has(std::string_view p_key, std::string_view p_section) const {
+	return Find(p_key, p_section) != nullptr;
+}
+
+bool INIView::Exists(std::string_view p_section) const {
+	Entry entry;
+	entry.section = p_section;
+
+	auto it = std::lower_bound(m_entries.begin(), m_entries.end(), entry, EntryLess);
+
+	return it != m_entries.end() and it->section == p_section;
+}
+
+Maybe<std::string_view> INIView::Value(std::string_view p_key, std::string_view p_section) const {
+	const Entry *entry = Find(p_key, p_section);
+	if (entry == nullptr)
+		return Maybe<std::string_view>::None();
+
+	return entry->value;
+}
+
+Maybe<bool> INIView::Bool(std::string_view p_key, std::string_view p_section) const {
+	const Entry *entry = Find(p_key, p_section);
+	if (entry == nullptr)
+		return Maybe<bool>::None();
+
+	return ParseBool(entry->value);
+}
+
+Maybe<int64_t> INIView::Int64(std::string_view p_key, std::string_view p_section) const {
+	const Entry *entry = Find(p_key, p_section);
+	if (entry == nullptr)
+		return Maybe<int64_t>::None();
+
+	return ParseNumber<int64_t>(entry->value);
+}
+
+Maybe<size_t> INIView::Size(std::string_view p_key, std::string_view p_section) const {
+	const Entry *entry = Find(p_key, p_section);
+	if (entry == nullptr)
+		return Maybe<size_t>::None();
+
+	return ParseNumber<size_t>(entry->value);
+}
+
+Maybe<float> INIView::Float(std::string_view p_key, std::string_view p_section) const {
+	const Entry *entry = Find(p_key, p_section);
+	if (entry == nullptr)
+		return Maybe<float>::None();
+
+	return ParseNumber<float>(entry->value);
+}
+
+const std::vector<INIView::Entry> &INIView::Entries() const {
+	return m_entries;
+}
+
+void INIView::Clear() {
+	m_entries.clear();
+	m_unescaped.clear();
+	m_file.Free();
+}
+
+const INIView::Entry *INIView::Find(std::string_view p_key, std::string_view p_section) const {
+	Entry entry;
+	entry.section = p_section;
+	entry.key     = p_key;
+
+	auto it = std::lower_bound(m_entries.begin(), m_entries.end(), entry, EntryLess);
+	if (it == m_entries.end() or it->section != p_section or it->key != p_key)
+		return nullptr;
+
+	return &*it;
+}
+
+bool INIView::LoadCache(const std::string &p_path, const FileStamp &p_stamp) {
+	auto file = MappedFile::Open(p_path);
+	if (not file.Ok())
 		return false;
-	else
-		return m_sections.at(p_section).count(p_key);
+
+	std::string_view data = file.Value().View();
+
+	CacheHeader header;
+	if (data.length() < sizeof(header))
+		return false;
+
+	std::memcpy(&header, data.data(), sizeof(header));
+	if (header.magic != INI_CACHE_MAGIC or header.version != INI_CACHE_VERSION or
+	    header.mtime != p_stamp.mtime or header.size != p_stamp.size)
+		return false;
+
+	size_t entriesSize = static_cast<size_t>(header.count) * sizeof(CacheEntry);
+	if (data.length() != sizeof(header) + entriesSize + header.blobSize)
+		return false;
+
+	m_file = std::move(file.Value());
+	data   = m_file.View();
+
+	std::string_view blob = data.substr(sizeof(header) + entriesSize);
+
+	m_entries.reserve(header.count);
+	for (size_t i = 0; i < header.count; ++ i) {
+		CacheEntry cached;
+		std::memcpy(&cached, data.data() + sizeof(header) + i * sizeof(CacheEntry), sizeof(cached));
+
+		if (cached.section + cached.sectionLen > blob.length() or
+		    cached.key     + cached.keyLen     > blob.length() or
+		    cached.value   + cached.valueLen   > blob.length()) {
+			Clear();
+
+			return false;
+		}
+
+		Entry entry;
+		entry.section = blob.substr(cached.section, cached.sectionLen);
+		entry.key     = blob.substr(cached.key,     cached.keyLen);
+		entry.value   = blob.substr(cached.value,   cached.valueLen);
+
+		m_entries.push_back(entry);
+	}
+
+	return true;
+}
+
+Error INIView::WriteCache(const std::string &p_path, const FileStamp &p_stamp) const {
+	std::string blob;
+	std::vector<CacheEntry> cached(m_entries.size());
+
+	auto append = [&blob](std::string_view p_str) {
+		uint32_t offset = static_cast<uint32_t>(blob.length());
+		blob.append(p_str);
+
+		return offset;
+	};
+
+	for (size_t i = 0; i < m_entries.size(); ++ i) {
+		const Entry &entry = m_entries[i];
+
+		// Entries are sorted by section, so consecutive ones can share the section string
+		if (i > 0 and entry.section == m_entries[i - 1].section)
+			cached[i].section = cached[i - 1].section;
+		else
+			cached[i].section = append(entry.section);
+
+		cached[i].sectionLen = static_cast<uint32_t>(entry.section.length());
+		cached[i].key        = append(entry.key);
+		cached[i].keyLen     = static_cast<uint32_t>(entry.key.length());
+		cached[i].value      = append(entry.value);
+		cached[i].valueLen   = static_cast<uint32_t>(entry.value.length());
+	}
+
+	CacheHeader header;
+	header.magic    = INI_CACHE_MAGIC;
+	header.version  = INI_CACHE_VERSION;
+	header.mtime    = p_stamp.mtime;
+	header.size     = p_stamp.size;
+	header.count    = static_cast<uint32_t>(cached.size());
+	header.blobSize = static_cast<uint32_t>(blob.length());
+
+	std::string content;
+	content.reserve(sizeof(header) + cached.size() * sizeof(CacheEntry) + blob.length());
+
+	content.append(reinterpret_cast<const char*>(&header), sizeof(header));
+	content.append(reinterpret_cast<const char*>(cached.data()), cached.size() * sizeof(CacheEntry));
+	content.append(blob);
+
+	return WriteFile(p_path, content);
+}
+
+Error INI::ParseFile(const std::string &p_path) {
+	INIView view;
+
+	auto err = view.ParseFile(p_path);
+	if (not err.Ok())
+		return err;
+
+	for (const auto &entry : view.Entries())
+		m_sections[std::string(entry.section)][std::string(entry.key)] = std::string(entry.value);
+
+	return Error::Fine();
+}
+
+bool INI::Has(const std::string &p_key, const std::string &p_section) {
+	return Find(p_key, p_section) != nullptr;
 }
 
 bool INI::Exists(const std::string &p_section) {
@@ -76,44 +409,35 @@ bool INI::Exists(const std::string &p_section) {
 }
 
 Maybe<bool> INI::Bool(const std::string &p_key, const std::string &p_section) {
-	try {
-		const std::string &val = m_sections.at(p_section).at(p_key);
-
-		if (val == "true" or val == "1")
-			return true;
-		else if (val == "false" or val == "0")
-			return false;
-		else
-			return Maybe<bool>::None();
-	} catch (...) {
+	const std::string *val = Find(p_key, p_section);
+	if (val == nullptr)
 		Panic("INI: Attempt to index non-existant key '", p_section, "::", p_key, "'");
-	}
 
-	SILENCE_RETURN_WARNING();
+	return ParseBool(*val);
 }
 
 Maybe<int64_t> INI::Int64(const std::string &p_key, const std::string &p_section) {
-	try {
-		return static_cast<int64_t>(std::stoll(m_sections.at(p_section).at(p_key)));
-	} catch (...) {
+	const std::string *val = Find(p_key, p_section);
+	if (val == nullptr)
 		return Maybe<int64_t>::None();
-	}
+
+	return ParseNumber<int64_t>(*val);
 }
 
 Maybe<size_t> INI::Size(const std::string &p_key, const std::string &p_section) {
-	try {
-		return static_cast<size_t>(std::stoull(m_sections.at(p_section).at(p_key)));
-	} catch (...) {
+	const std::string *val = Find(p_key, p_section);
+	if (val == nullptr)
 		return Maybe<size_t>::None();
-	}
+
+	return ParseNumber<size_t>(*val);
 }
 
 Maybe<float> INI::Float(const std::string &p_key, const std::string &p_section) {
-	try {
-		return std::stof(m_sections.at(p_section).at(p_key));
-	} catch (...) {
+	const std::string *val = Find(p_key, p_section);
+	if (val == nullptr)
 		return Maybe<float>::None();
-	}
+
+	return ParseNumber<float>(*val);
 }
 
 INI::Section &INI::operator [](const std::string &p_section) {
@@ -172,39 +496,16 @@ void INI::Clear() {
 	m_sections.clear();
 }
 
-ErrorOr<std::string> INI::Unescape(const std::string &p_str) {
-	std::string unescaped;
-
-	bool escape = false;
-	for (auto it = p_str.begin(); it < p_str.end(); ++ it) {
-		switch (*it) {
-		case '\\': escape = true; break;
+const std::string *INI::Find(const std::string &p_key, const std::string &p_section) const {
+	auto section = m_sections.find(p_section);
+	if (section == m_sections.end())
+		return nullptr;
 
-		default:
-			if (escape) {
-				switch (*it) {
-				case 'n':  unescaped += '\n';   break;
-				case 'r':  unescaped += '\r';   break;
-				case 't':  unescaped += '\t';   break;
-				case 'f':  unescaped += '\f';   break;
-				case 'b':  unescaped += '\b';   break;
-				case 'a':  unescaped += '\a';   break;
-				case 'e':  unescaped += '\x1b'; break;
-				case '"':  unescaped += '"';    break;
-				case '\\': unescaped += '\\';   break;
-
-				default:
-					size_t idx = static_cast<size_t>(p_str.begin() - it) + 1;
-
-					return ErrorOr<std::string>::Make("Unknown escape sequence '\\", *it,
-					                                  "' at char ", idx);
-				}
-			} else
-				unescaped += *it;
-		}
-	}
+	auto it = section->second.find(p_key);
+	if (it == section->second.end())
+		return nullptr;
 
-	return ErrorOr<std::string>::Fine(unescaped);
+	return &it->second;
 }
 
 }
@@ -1,12 +1,21 @@
 #ifndef INI_HH__HEADER_GUARD__
 #define INI_HH__HEADER_GUARD__
 
-#include <string>        // std::string, std::stof, std::stoll
+#include <string>        // std::string
+#include <string_view>   // std::string_view
 #include <unordered_map> // std::unordered_map
-#include <cstdint>       // std::int64_t
-#include <fstream>       // std::ifstream, std::getline
+#include <vector>        // std::vector
+#include <deque>         // std::deque
+#include <algorithm>     // std::stable_sort, std::lower_bound
+#include <charconv>      // std::from_chars
+#include <cstdint>       // std::int64_t, std::uint32_t
+#include <cstring>       // std::memcpy
 
 #include "utils.hh"
+#include "file.hh"
+
+#define INI_CACHE_MAGIC   0x494E4943 // "CINI"
+#define INI_CACHE_VERSION 2
 
 namespace CityBuilder {
 
@@ -14,10 +23,80 @@ namespace CityBuilder {
 // - Both ; and # comments
 // - Empty section
 // - Any text after ']' in section declaration
+// - LF and CRLF line endings
 
 // Unsupported:
 // - Comments in the same line with an assignment
 
+// Read-only INI document. Keys and values are views into the mapped file (or the compiled cache),
+// only values with escape sequences get their own storage. Lookups are a binary search over the
+// entries sorted by section and key, and typed lookups never throw
+class INIView {
+public:
+	struct Entry {
+		std::string_view section, key, value;
+	};
+
+	INIView() {}
+
+	INIView(const INIView &p_copy) = delete;
+	INIView(INIView &&p_move)      = delete;
+
+	// If p_cachePath is not empty, a compiled binary copy of the file is stored there and used
+	// instead of parsing for as long as the file modification time and size match
+	Error ParseFile(const std::string &p_path, const std::string &p_cachePath = "");
+	// p_src has to outlive the INIView
+	Error Parse(std::string_view p_src);
+
+	template <typename... Args>
+	bool HasInSection(std::string_view p_section, Args... p_args) const {
+		size_t count = 0;
+
+		((count += not Has(p_args, p_section)), ...);
+
+		return not count;
+	}
+
+	bool Has(std::string_view p_key, std::string_view p_section = "") const;
+	bool Exists(std::string_view p_section) const;
+
+	Maybe<std::string_view> Value(std::string_view p_key, std::string_view p_section = "") const;
+
+	Maybe<bool>    Bool(std::string_view p_key,  std::string_view p_section = "") const;
+	Maybe<int64_t> Int64(std::string_view p_key, std::string_view p_section = "") const;
+	Maybe<size_t>  Size(std::string_view p_key,  std::string_view p_section = "") const;
+	Maybe<float>   Float(std::string_view p_key, std::string_view p_section = "") const;
+
+	const std::vector<Entry> &Entries() const;
+
+	void Clear();
+
+private:
+	struct CacheHeader {
+		uint32_t magic, version;
+		int64_t  mtime;
+		uint64_t size;
+		uint32_t count, blobSize;
+	};
+
+	struct CacheEntry {
+		uint32_t section, sectionLen, key, keyLen, value, valueLen;
+	};
+
+	Error ParseSource(std::string_view p_src);
+	Error Store(std::string_view p_str, std::string_view &p_stored);
+
+	const Entry *Find(std::string_view p_key, std::string_view p_section) const;
+
+	bool  LoadCache(const std::string &p_path, const FileStamp &p_stamp);
+	Error WriteCache(const std::string &p_path, const FileStamp &p_stamp) const;
+
+	MappedFile              m_file;
+	std::deque<std::string> m_unescaped;
+	std::vector<Entry>      m_entries;
+};
+
+// Mutable INI document, a parsed INIView copied into maps
 class INI {
 public:
 	using Section = std::unordered_map<std::string, std::string>;
@@ -56,7 +135,7 @@ public:
 	void Clear();
 
 private:
-	ErrorOr<std::string> Unescape(const std::string &p_str);
+	const std::string *Find(const std::string &p_key, const std::string &p_section) const;
 
 	std::unordered_map<std::string, Section> m_sections;
 };
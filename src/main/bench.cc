@@ -0,0 +1,91 @@
+#include "bench.hh"
+
+namespace CityBuilder {
+
+Benchmark::Benchmark():
+	m_active(false),
+	m_frames(0),
+	m_frame(0),
+
+	m_startCounter(0),
+	m_prevCounter(0),
+	m_tiles(0)
+{}
+
+void Benchmark::Start(size_t p_frames, const Vec2i &p_worldSize) {
+	m_active    = true;
+	m_frames    = p_frames;
+	m_frame     = 0;
+	m_worldSize = p_worldSize;
+	m_tiles     = 0;
+
+	m_frameTimes.clear();
+	m_frameTimes.reserve(p_frames);
+}
+
+bool Benchmark::Active() const {
+	return m_active;
+}
+
+bool Benchmark::Done() const {
+	return m_active and m_frame > m_frames;
+}
+
+void Benchmark::Frame(Camera &p_camera, size_t p_visibleTiles) {
+	uint64_t counter = SDL_GetPerformanceCounter();
+
+	// The first call only starts the clock, there is no frame before it to time
+	if (m_frame == 0)
+		m_startCounter = counter;
+	else {
+		double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+
+		m_frameTimes.push_back((counter - m_prevCounter) * 1000 / frequency);
+		m_tiles += p_visibleTiles;
+	}
+
+	m_prevCounter = counter;
+
+	// An ellipse around the middle of the map, zooming all the way in and out twice per lap
+	double t     = static_cast<double>(m_frame) / m_frames * BENCH_LAPS * 2 * M_PI;
+	Vec2f  world = static_cast<Vec2f>(m_worldSize) * static_cast<Vec2f>(TILE_SIZE);
+
+	p_camera.pos.x = std::cos(t) * world.x / 4;
+	p_camera.pos.y = world.y / 2 + std::sin(t) * world.y / 4;
+	p_camera.zoom  = ZOOM_MIN + (ZOOM_MAX - ZOOM_MIN) * (0.5 - std::cos(t * 2) / 2);
+
+	++ m_frame;
+}
+
+void Benchmark::Report(std::ostream &p_stream) const {
+	std::vector<double> sorted = m_frameTimes;
+	std::sort(sorted.begin(), sorted.end());
+
+	double total = 0;
+	for (double time : sorted)
+		total += time;
+
+	size_t frames = sorted.size();
+	double secs   = total / 1000;
+
+	p_stream << "{\"frames\":"        << frames
+	         << ",\"world_size\":"     << m_worldSize.x
+	         << ",\"total_ms\":"       << total
+	         << ",\"mean_ms\":"        << (frames > 0? total / frames : 0)
+	         << ",\"p50_ms\":"         << Percentile(sorted, 50)
+	         << ",\"p90_ms\":"         << Percentile(sorted, 90)
+	         << ",\"p99_ms\":"         << Percentile(sorted, 99)
+	         << ",\"max_ms\":"         << (frames > 0? sorted.back() : 0)
+	         << ",\"fps\":"            << (secs > 0? frames / secs : 0)
+	         << ",\"tiles_per_sec\":"  << (secs > 0? m_tiles / secs : 0)
+	         << "}" << std::endl;
+}
+
+double Benchmark::Percentile(const std::vector<double> &p_sorted, float p_percent) const {
+	if (p_sorted.empty())
+		return 0;
+
+	return p_sorted[static_cast<size_t>(std::round((p_sorted.size() - 1) * p_percent / 100))];
+}
+
+}
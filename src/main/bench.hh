@@ -0,0 +1,60 @@
+#ifndef BENCH_HH__HEADER_GUARD__
+#define BENCH_HH__HEADER_GUARD__
+
+#include <vector>    // std::vector
+#include <ostream>   // std::ostream
+#include <algorithm> // std::sort
+#include <cmath>     // std::cos, std::sin, std::round
+#include <cstdint>   // std::uint64_t
+
+#include <SDL2/SDL.h>
+
+#include "config.hh"
+
+#include "../utils.hh"
+#include "../units.hh"
+#include "../math.hh"
+#include "../world/camera.hh"
+#include "../world/tile.hh"
+
+#define BENCH_WORLD_SIZE 256
+#define BENCH_FRAMES     1000
+
+// How many times the camera goes around its path during a run
+#define BENCH_LAPS 2
+
+namespace CityBuilder {
+
+// Drives the camera along a scripted path for a fixed number of frames and reports the frame
+// times. The path only depends on the frame number, so runs are comparable
+class Benchmark {
+public:
+	Benchmark();
+
+	void Start(size_t p_frames, const Vec2i &p_worldSize);
+
+	bool Active() const;
+	bool Done() const;
+
+	// Has to be called once every frame, times the previous one and moves the camera for the next
+	void Frame(Camera &p_camera, size_t p_visibleTiles);
+
+	// A single JSON object on one line
+	void Report(std::ostream &p_stream) const;
+
+private:
+	double Percentile(const std::vector<double> &p_sorted, float p_percent) const;
+
+	bool   m_active;
+	size_t m_frames, m_frame;
+	Vec2i  m_worldSize;
+
+	uint64_t m_startCounter, m_prevCounter;
+	size_t   m_tiles;
+
+	std::vector<double> m_frameTimes; // Milliseconds
+};
+
+}
+
+#endif
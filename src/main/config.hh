@@ -22,8 +22,18 @@ namespace CityBuilder {
 
 #define CITY_BUILDER_DEBUG
 
+// Records timed zones, written as Chrome trace JSON into PROFILER_OUTPUT when the game quits
+//#define CITY_BUILDER_PROFILE
+#define PROFILER_OUTPUT "profile.json"
+
 #define FPS_CAP 60
 
+// Events polled but not handled yet, polling stops when it fills up
+#define INPUT_QUEUE_SIZE 256
+
+// When nothing on screen changes, the game blocks waiting for events for at most this long
+#define IDLE_WAIT_MS 250
+
 #define SCREEN_W    448
 #define SCREEN_H    256
 #define SCREEN_SIZE Vec2i(SCREEN_W, SCREEN_H)
@@ -32,6 +42,9 @@ namespace CityBuilder {
 
 #define MAP_SIZE 10
 
+// Undo history is dropped from the oldest edits when it grows over this many bytes
+#define JOURNAL_MEMORY_CAP (4 * 1024 * 1024)
+
 #define CAM_SENSITIVITY  2
 #define DRAG_SENSITIVITY 0.6
 
@@ -0,0 +1,92 @@
+#include "frame_pacer.hh"
+
+namespace CityBuilder {
+
+FramePacer::FramePacer(float p_fps):
+	m_mode(Mode::Sleep),
+
+	m_frequency(SDL_GetPerformanceFrequency()),
+	m_period(static_cast<uint64_t>(m_frequency / p_fps)),
+	m_start(0),
+	m_next(0),
+
+	m_frameTime(0),
+	m_jitter(0)
+{}
+
+void FramePacer::SetMode(Mode p_mode) {
+	m_mode = p_mode;
+
+	Reset();
+}
+
+FramePacer::Mode FramePacer::GetMode() const {
+	return m_mode;
+}
+
+void FramePacer::BeginFrame() {
+	uint64_t now = SDL_GetPerformanceCounter();
+
+	if (m_start != 0) {
+		float delta = static_cast<float>((now - m_start) * 1000.0 / m_frequency);
+
+		// The first measured frame seeds the average, instead of climbing up from 0
+		if (m_frameTime == 0)
+			m_frameTime = delta;
+		else
+			m_frameTime += (delta - m_frameTime) * FRAME_PACER_SMOOTHING;
+
+		float target = m_mode == Mode::Sleep? m_period * 1000.0f / m_frequency : m_frameTime;
+		m_jitter += (std::abs(delta - target) - m_jitter) * FRAME_PACER_SMOOTHING;
+	}
+
+	m_start = now;
+}
+
+void FramePacer::Wait() {
+	if (m_mode != Mode::Sleep)
+		return;
+
+	m_next = m_next == 0? m_start + m_period : m_next + m_period;
+
+	uint64_t now = SDL_GetPerformanceCounter();
+	if (now >= m_next) {
+		// Too far behind (a hitch, the window being dragged), rushing frames to catch up would
+		// only stutter more
+		if (now - m_next > m_period)
+			m_next = now;
+
+		return;
+	}
+
+	double ms = (m_next - now) * 1000.0 / m_frequency;
+	if (ms > FRAME_PACER_SPIN_MS)
+		SDL_Delay(static_cast<uint32_t>(ms - FRAME_PACER_SPIN_MS));
+
+	while (SDL_GetPerformanceCounter() < m_next) {}
+}
+
+void FramePacer::Reset() {
+	m_start = 0;
+	m_next  = 0;
+}
+
+float FramePacer::Fps() const {
+	return m_frameTime == 0? 0 : 1000 / m_frameTime;
+}
+
+float FramePacer::FrameTime() const {
+	return m_frameTime;
+}
+
+float FramePacer::Jitter() const {
+	return m_jitter;
+}
+
+const char *FramePacer::ModeName(Mode p_mode) {
+	static const char *names[] = {"sleep", "vsync", "unlimited"};
+
+	return names[static_cast<size_t>(p_mode)];
+}
+
+}
@@ -0,0 +1,64 @@
+#ifndef FRAME_PACER_HH__HEADER_GUARD__
+#define FRAME_PACER_HH__HEADER_GUARD__
+
+#include <cstdint> // std::uint64_t
+#include <cmath>   // std::abs
+
+#include <SDL2/SDL.h>
+
+#include "config.hh"
+
+#include "../utils.hh"
+
+// SDL_Delay can oversleep by a millisecond or more, so the last part of the wait is spun
+#define FRAME_PACER_SPIN_MS 2
+
+// How fast the averaged frame time and jitter follow new frames
+#define FRAME_PACER_SMOOTHING 0.05
+
+namespace CityBuilder {
+
+// Paces frames with the high resolution counter. Frames are scheduled on an absolute timeline,
+// so a frame that ends early or late does not shift all the following ones
+class FramePacer {
+public:
+	enum class Mode {
+		Sleep = 0, // Sleep coarsely, then spin until the frame is due
+		VSync,     // Present blocks until the vertical blank, nothing to wait for
+		Unlimited  // Headless runs
+	};
+
+	FramePacer(float p_fps = FPS_CAP);
+
+	void SetMode(Mode p_mode);
+	Mode GetMode() const;
+
+	// Has to be called at the start of every frame, measures the previous one
+	void BeginFrame();
+	// Waits until the next frame is due
+	void Wait();
+	// Drops the schedule after the loop was blocked (waiting for events), so the next frame is
+	// not rushed or counted as a stutter
+	void Reset();
+
+	float Fps() const;
+	// Averaged, in milliseconds
+	float FrameTime() const;
+	// Average deviation of frame times from the target (or from the average in other modes), in
+	// milliseconds
+	float Jitter() const;
+
+	static const char *ModeName(Mode p_mode);
+
+private:
+	Mode m_mode;
+
+	uint64_t m_frequency, m_period;
+	uint64_t m_start, m_next;
+
+	float m_frameTime, m_jitter;
+};
+
+}
+
+#endif
@@ -29,18 +29,54 @@ Game::Game(int p_argc, char **p_argv):
 
 	tick(0),
 
-	m_baseViewport(SCREEN_RECT),
-	m_viewport(SCREEN_RECT),
+	m_mouseWheel(0),
+
+	m_tool(Tool::Brush),
+	m_dragTool(Tool::Brush),
+	m_brush(Tile::Dirt),
+
+	m_paintedTile(-1),
+	m_editStart(0),
 
 	m_state(Game::State::InMenu),
-	m_menu(Game::Menu::Home)
-{
-	UNUSED(p_argc);
-	UNUSED(p_argv);
+	m_menu(Game::Menu::Home),
+
+	m_sim(world),
 
+	m_settledCameraZoom(0),
+	m_settledWorldVersion(0),
+
+	m_benchSize(BENCH_WORLD_SIZE),
+	m_benchFrames(BENCH_FRAMES)
+{
 	m_instance = this;
 
 	std::memset(&m_flag, 0, sizeof(m_flag));
+	m_flag.redraw = true;
+
+	ParseArgs(p_argc, p_argv);
+
+	if (not m_replayPath.empty()) {
+		auto err = m_replayer.Open(m_replayPath);
+		if (not err.Ok())
+			Panic(err);
+
+		m_flag.headless = true;
+	}
+
+	// Benchmarks have to run the same on hosts without a display or a GPU
+	if (m_flag.bench)
+		m_flag.headless = true;
+
+	if (not m_recordPath.empty()) {
+		auto err = m_recorder.Open(m_recordPath);
+		if (not err.Ok())
+			Panic(err);
+	}
+
+	// A replay needs no real window, the dummy driver with a software renderer is enough
+	if (m_flag.headless)
+		SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
 
 	if (SDL_Init(SDL_INIT_VIDEO) != 0)
 		Panic("SDL2 Error: ", SDL_GetError());
@@ -50,7 +86,8 @@ Game::Game(int p_argc, char **p_argv):
 #endif
 
 	window = SDL_CreateWindow(TITLE, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-	                          SCREEN_W * SCALE, SCREEN_H * SCALE, SDL_WINDOW_RESIZABLE);
+	                          SCREEN_W * SCALE, SCREEN_H * SCALE,
+	                          m_flag.headless? SDL_WINDOW_HIDDEN : SDL_WINDOW_RESIZABLE);
 	if (window == nullptr)
 		Panic("SDL2 Error: ", SDL_GetError());
 #ifdef CITY_BUILDER_LOG
@@ -58,7 +95,13 @@ Game::Game(int p_argc, char **p_argv):
 		Log("Created the window");
 #endif
 
-	renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+	uint32_t rendererFlags = SDL_RENDERER_ACCELERATED;
+	if (m_flag.headless)
+		rendererFlags = SDL_RENDERER_SOFTWARE;
+	else if (m_flag.vsync)
+		rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+
+	renderer = SDL_CreateRenderer(window, -1, rendererFlags);
 	if (renderer == nullptr)
 		Panic("SDL2 Error: ", SDL_GetError());
 #ifdef CITY_BUILDER_LOG
@@ -66,6 +109,21 @@ Game::Game(int p_argc, char **p_argv):
 		Log("Created the renderer");
 #endif
 
+	if (m_flag.headless)
+		pacer.SetMode(FramePacer::Mode::Unlimited);
+	else if (m_flag.vsync) {
+		// Drivers are allowed to ignore the vsync request, then frames would run uncapped
+		SDL_RendererInfo info;
+		if (SDL_GetRendererInfo(renderer, &info) == 0 and info.flags & SDL_RENDERER_PRESENTVSYNC)
+			pacer.SetMode(FramePacer::Mode::VSync);
+#ifdef CITY_BUILDER_LOG
+		else
+			Log("VSync is not supported by the renderer, pacing by sleeping");
+#endif
+	}
+
+	renderContext.Init(renderer);
+
 	if (not SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "nearest"))
 		Panic("SDL2 Error: ", SDL_GetError());
 #ifdef CITY_BUILDER_LOG
@@ -94,7 +152,7 @@ Game::Game(int p_argc, char **p_argv):
 	SDL_SetWindowIcon(window, icon);
 	SDL_FreeSurface(icon);
 
-	m_keyboard = SDL_GetKeyboardState(nullptr);
+	m_keyboard = m_replayer.Active()? m_replayer.Keyboard() : SDL_GetKeyboardState(nullptr);
 
 	Log("--------------------------------");
 
@@ -110,11 +168,56 @@ Game::Game(int p_argc, char **p_argv):
 	Log("Initialized UI styles");
 #endif
 
-	InitTimers();
+	if (m_flag.bench) {
+		world.Resize(Vec2i(m_benchSize));
+		SetState(State::InGame);
+
+		m_bench.Start(m_benchFrames, world.size);
 
 #ifdef CITY_BUILDER_LOG
-	Log("Initialized timers");
+		Log("Benchmarking ", m_benchFrames, " frames in a ", m_benchSize, "x", m_benchSize,
+		    " world");
 #endif
+	}
+}
+
+static size_t ParseCountArg(const std::string &p_arg, const std::string &p_value) {
+	size_t count;
+	auto   end = p_value.data() + p_value.size();
+	auto   ret = std::from_chars(p_value.data(), end, count);
+
+	if (ret.ec != std::errc() or ret.ptr != end or count == 0)
+		Panic("Expected a positive number after '", p_arg, "', got '", p_value, "'");
+
+	return count;
+}
+
+void Game::ParseArgs(int p_argc, char **p_argv) {
+	for (int i = 1; i < p_argc; ++ i) {
+		std::string arg = p_argv[i];
+
+		if (arg == "--record" or arg == "--replay") {
+			if (i + 1 >= p_argc)
+				Panic("Expected a file path after '", arg, "'");
+
+			(arg == "--record"? m_recordPath : m_replayPath) = p_argv[++ i];
+		} else if (arg == "--vsync")
+			m_flag.vsync = true;
+		else if (arg == "--bench")
+			m_flag.bench = true;
+		// Only adjust the benchmark, it still has to be turned on with --bench
+		else if (arg == "--bench-size" or arg == "--bench-frames") {
+			if (i + 1 >= p_argc)
+				Panic("Expected a number after '", arg, "'");
+
+			size_t count = ParseCountArg(arg, p_argv[++ i]);
+			(arg == "--bench-size"? m_benchSize : m_benchFrames) = count;
+		} else
+			Panic("Unknown argument '", arg, "'");
+	}
+
+	if (m_flag.bench and not m_replayPath.empty())
+		Panic("'--bench' and '--replay' can not be used together");
 }
 
 void Game::LoadTexture(const std::string &p_key, const std::string &p_path) {
@@ -125,7 +228,7 @@ void Game::LoadTexture(const std::string &p_key, const std::string &p_path) {
 
 void Game::LoadFont(const std::string &p_key,
                     const std::string &p_sheetPath, const std::string &p_infoPath) {
-	auto err = fonts.FromFile(p_key, p_sheetPath, p_infoPath);
+	auto err = fonts.FromFile(p_key, p_sheetPath, p_infoPath, textures);
 	if (not err.Ok())
 		Panic(err);
 }
@@ -144,10 +247,19 @@ void Game::LoadAssets() {
 
 	LoadFont("default", "./res/fonts/default.bmp", "./res/fonts/default.ini");
 
+	auto err = textures.BuildAtlas();
+	if (not err.Ok())
+		Panic(err);
+
+	fonts.BindSheets(textures);
+
 	assert(UI_FONT_W == fonts.Get("default").CharW());
 	assert(UI_FONT_H == fonts.Get("default").CharH());
 
 	tileSheet.SetSheet(textures.Get("tile_sheet"));
+
+	m_textures.logo       = textures.Intern("logo");
+	m_textures.backButton = textures.Intern("buttons/back");
 	//buildingSheet.SetSheet(textures.Get("building_sheet")); // TODO: Building sheet
 }
 
@@ -166,7 +278,17 @@ void Game::InitUIStyles() {
 	style.textLabel.color[UI::Style::TextLabel::Text]   = Color4f(199, 207, 221);
 	style.textLabel.color[UI::Style::TextLabel::Shadow] = Color4f(0);
 
-	styles.Add("black_screen", style);
+	m_styles.blackScreen = styles.Add("black_screen", style);
+
+	/* Performance overlay style */
+	style.graph.background = Color4f(0, 0, 0, 150);
+	style.graph.bar        = Color4f(199, 207, 221);
+	style.graph.mark       = Color4f(93,  44,  40);
+
+	style.minimap.background = Color4f(0, 0, 0, 150);
+	style.minimap.view       = Color4f(199, 207, 221);
+
+	m_styles.overlay = styles.Add("overlay", style);
 
 	/* Dialog style */
 	style.frame.texture = &textures.Get("frames/dialog");
@@ -184,7 +306,7 @@ void Game::InitUIStyles() {
 
 	style.textButton.texture = &textures.Get("buttons/default");
 
-	styles.Add("dialog", style);
+	m_styles.dialog = styles.Add("dialog", style);
 
 	/* List style */
 	style.frame.texture = &textures.Get("frames/list");
@@ -202,7 +324,7 @@ void Game::InitUIStyles() {
 
 	style.textButton.texture = &textures.Get("buttons/default");
 
-	styles.Add("list", style);
+	m_styles.list = styles.Add("list", style);
 
 	/* Menu style */
 	style.frame.texture = &textures.Get("frames/menu");
@@ -220,46 +342,37 @@ void Game::InitUIStyles() {
 
 	style.textButton.texture = &textures.Get("buttons/menu");
 
-	styles.Add("menu", style);
+	m_styles.menu = styles.Add("menu", style);
 }
 
-void Game::InitTimers() {
-	m_timers.Init(Timer::FadeOut, UI_FADEOUT_TIME, [this]() {
-		switch (m_state) {
-		case State::InMenu:
-			SetState(State::InGame);
-			m_timers.Start(Timer::FadeIn);
-
-			break;
-
-		case State::InGame:
-			SetState(State::InMenu);
-			m_timers.Start(Timer::FadeIn);
-
-			m_flag.disableUI = true;
-
-			break;
-
-		default: UNREACHABLE();
-		}
-	});
+Game::~Game() {
+#ifdef CITY_BUILDER_LOG
+	Log("--------------------------------");
+#endif
 
-	m_timers.Init(Timer::FadeIn, UI_FADEIN_TIME, [this]() {
-		switch (m_state) {
-		case State::InMenu: m_flag.disableUI = false; break;
+	// The last update kicked a tick, it has to stop recording before the profile is exported
+	m_sim.Wait();
 
-		default: break;
-		}
-	});
-}
+	m_recorder.Close();
 
-Game::~Game() {
 #ifdef CITY_BUILDER_LOG
-	Log("--------------------------------");
+	Memory::LogUsage();
+#endif
+
+#ifdef CITY_BUILDER_PROFILE
+	auto err = Profiler::Export(PROFILER_OUTPUT);
+	if (not err.Ok())
+		std::cerr << err.Desc() << std::endl;
+#	ifdef CITY_BUILDER_LOG
+	else
+		Log("Wrote profile into '", PROFILER_OUTPUT, "'");
+#	endif
 #endif
 
 	textRenderer.ClearCache();
+	textures.Clear();
 	fonts.Clear();
+	m_minimap.Clear();
 #ifdef CITY_BUILDER_LOG
 	Log("Destroyed all assets");
 #endif
@@ -279,7 +392,43 @@ Game::~Game() {
 }
 
 void Game::RenderDarkenScreen(float p_a) {
-	SDL_RenderColoredRect(renderer, SCREEN_RECT, Color4f(0, 0, 0, p_a));
+	// Goes through the draw list so it stays in order with the UI around it
+	drawList.ResetClip();
+	drawList.Fill(SCREEN_RECT, Color4f(0, 0, 0, p_a));
+}
+
+void Game::FadeOut() {
+	m_timers.Cancel(m_fade.out);
+	m_fade.out = m_timers.Schedule(UI_FADEOUT_TIME, [this]() {
+		switch (m_state) {
+		case State::InMenu:
+			SetState(State::InGame);
+			FadeIn();
+
+			break;
+
+		case State::InGame:
+			SetState(State::InMenu);
+			FadeIn();
+
+			m_flag.disableUI = true;
+
+			break;
+
+		default: UNREACHABLE();
+		}
+	});
+}
+
+void Game::FadeIn() {
+	m_timers.Cancel(m_fade.in);
+	m_fade.in = m_timers.Schedule(UI_FADEIN_TIME, [this]() {
+		switch (m_state) {
+		case State::InMenu: m_flag.disableUI = false; break;
+
+		default: break;
+		}
+	});
 }
 
 Game::DialogResponse Game::UIDialog(const std::string &p_text) {
@@ -287,7 +436,7 @@ Game::DialogResponse Game::UIDialog(const std::string &p_text) {
 
 	RenderDarkenScreen(100);
 
-	ui.style = &styles.Get("dialog");
+	ui.style = &styles.Get(m_styles.dialog);
 	ui.Begin(UI_DIALOG_POS);
 	{
 		ui.BeginFrame(UI_DIALOG_SIZE, UI::Layout::Vert, UI_DIALOG_PADDING);
@@ -320,8 +469,15 @@ Game::DialogResponse Game::UIDialog(const std::string &p_text) {
 }
 
 void Game::Render() {
-	SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
-	SDL_RenderClear(renderer);
+	// The previous image is still on screen, there is nothing new to draw
+	if (not NeedsRedraw())
+		return;
+
+	PROFILE_ZONE("Game::Render");
+
+	SettleRedraw();
+
+	renderContext.Clear(Color4i(0, 0, 0, SDL_ALPHA_OPAQUE));
 
 	switch (m_state) {
 	case State::InMenu:  RenderMenu();    break;
@@ -330,27 +486,48 @@ void Game::Render() {
 	default: UNREACHABLE();
 	}
 
-	if (m_timers.Active(Timer::FadeIn))
-		RenderDarkenScreen(m_timers.GetUnit(Timer::FadeIn) * 255);
-	else if (m_timers.Active(Timer::FadeOut))
-		RenderDarkenScreen(m_timers.GetUnit(Timer::FadeOut, true) * 255);
+	if (m_timers.Pending(m_fade.in)) {
+		float unit = static_cast<float>(m_timers.Remaining(m_fade.in)) / UI_FADEIN_TIME;
+		RenderDarkenScreen(unit * 255);
+	} else if (m_timers.Pending(m_fade.out)) {
+		float unit = static_cast<float>(m_timers.Remaining(m_fade.out)) / UI_FADEOUT_TIME;
+		RenderDarkenScreen((1 - unit) * 255);
+	}
+
+	if (m_overlay.Visible()) {
+		ui.style = &styles.Get(m_styles.overlay);
+		m_overlay.Render(ui);
+	}
+
+	drawList.Submit(renderContext);
 
-	SDL_RenderPresent(renderer);
+	renderContext.Present();
 }
 
 void Game::RenderGame() {
-	SDL_RenderColoredRect(renderer, SCREEN_RECT, Color4f(19, 19, 19));
+	PROFILE_ZONE("Game::RenderGame");
+
+	renderContext.FillRect(SCREEN_RECT, Color4f(19, 19, 19));
 
 	world.Render();
 
-	if (m_flag.paused)
+	if (m_flag.paused) {
 		RenderPaused();
+
+		return;
+	}
+
+	Vec2f pos;
+
+	ui.style = &styles.Get(m_styles.overlay);
+	if (m_minimap.Render(ui, ID::Minimap, world.Front(), pos))
+		Submit(Command::JumpCamera(pos));
 }
 
 void Game::RenderPaused() {
 	RenderDarkenScreen(100);
 
-	ui.style = &styles.Get("black_screen");
+	ui.style = &styles.Get(m_styles.blackScreen);
 	ui.Begin(UI_TEXT_CENTER(UI_PAUSED_TEXT, SCREEN_W, SCREEN_H, 1));
 	{
 		ui.TextLabel(UI_PAUSED_TEXT);
@@ -360,20 +537,22 @@ void Game::RenderPaused() {
 	ui.Begin(UI_PAUSED_BUTTON_POS);
 	{
 		if (ui.ImageButton(ID::Button_Paused, UI_PAUSED_BUTTON_SIZE,
-		                   textures.Get("buttons/back"))) {
+		                   textures.Get(m_textures.backButton))) {
 			m_flag.paused = false;
 
-			m_timers.Start(Timer::FadeOut);
+			FadeOut();
 		}
 	}
 	ui.End();
 }
 
 void Game::RenderMenu() {
-	ui.style = &styles.Get("menu");
+	PROFILE_ZONE("Game::RenderMenu");
+
+	ui.style = &styles.Get(m_styles.menu);
 	ui.Begin(UI_MENU_POS, UI::Layout::Vert);
 	{
-		ui.ImageLabel(textures.Get("logo"));
+		ui.ImageLabel(textures.Get(m_textures.logo));
 
 		ui.BeginFrame(UI_MENU_SIZE, UI::Layout::Vert);
 		{
@@ -387,7 +566,7 @@ void Game::RenderMenu() {
 
 			if (ui.TextButton(ID::Button_Menu_Start, UI_MENU_BUTTON_SIZE,
 			                  UI_MENU_BUTTON_START_TEXT, 1, Vec2f(), active))
-				m_timers.Start(Timer::FadeOut);
+				FadeOut();
 
 			if (ui.TextButton(ID::Button_Menu_Settings, UI_MENU_BUTTON_SIZE,
 			                  UI_MENU_BUTTON_SETTINGS_TEXT, 1, Vec2f(), active))
@@ -427,7 +606,7 @@ void Game::RenderMenu() {
 }
 
 void Game::RenderMenuHome() {
-	ui.style = &styles.Get("list");
+	ui.style = &styles.Get(m_styles.list);
 	ui.Begin(UI_LIST_POS);
 	{
 		ui.BeginFrame(UI_LIST_SIZE, UI::Layout::Vert);
@@ -449,7 +628,7 @@ void Game::RenderMenuStart() {
 }
 
 void Game::RenderMenuSettings() {
-	ui.style = &styles.Get("dialog");
+	ui.style = &styles.Get(m_styles.dialog);
 	ui.Begin(UI_LIST_POS);
 	{
 	}
@@ -457,7 +636,7 @@ void Game::RenderMenuSettings() {
 }
 
 void Game::RenderMenuCredits() {
-	ui.style = &styles.Get("list");
+	ui.style = &styles.Get(m_styles.list);
 	ui.Begin(UI_LIST_POS);
 	{
 		ui.BeginFrame(UI_LIST_SIZE, UI::Layout::Vert);
@@ -474,28 +653,33 @@ void Game::RenderMenuCredits() {
 	ui.End();
 }
 
-void Game::Input() {
-	while (SDL_PollEvent(&m_event)) {
-		switch (m_event.type) {
-		case SDL_QUIT: m_flag.quit = true; break;
+bool Game::PollEvent() {
+	if (m_replayer.Active()) {
+		if (not m_replayer.PollEvent(tick, m_event))
+			return false;
+	} else {
+		if (not SDL_PollEvent(&m_event))
+			return false;
 
-		case SDL_WINDOWEVENT:
-			switch (m_event.window.event) {
-			case SDL_WINDOWEVENT_RESIZED:
-			case SDL_WINDOWEVENT_SIZE_CHANGED:
-				{
-					SDL_Rect viewport;
-					SDL_RenderGetViewport(renderer, &viewport);
+		m_recorder.Event(tick, m_event);
+	}
 
-					m_baseViewport = viewport;
-				}
+	// Any input may change what is on screen
+	m_flag.redraw = true;
 
-				break;
+	return true;
+}
 
-			default: break;
-			}
+void Game::Input() {
+	PROFILE_ZONE("Game::Input");
 
-			break;
+	m_mouseWheel = 0;
+
+	PumpEvents();
+
+	while (m_events.Pop(m_event)) {
+		switch (m_event.type) {
+		case SDL_QUIT: m_flag.quit = true; break;
 
 		case SDL_MOUSEMOTION:
 			m_prevMouse = m_mouse;
@@ -518,6 +702,17 @@ void Game::Input() {
 
 			break;
 
+		case SDL_MOUSEWHEEL:
+			m_mouseWheel += m_event.wheel.y;
+
+			break;
+
+		case SDL_KEYDOWN:
+			if (m_event.key.keysym.sym == SDLK_F3)
+				m_overlay.Toggle();
+
+			break;
+
 		default: break;
 		}
 
@@ -528,6 +723,14 @@ void Game::Input() {
 		}
 	}
 
+	if (m_replayer.Active()) {
+		m_replayer.UpdateKeyboard(tick);
+
+		if (m_replayer.Done())
+			m_flag.quit = true;
+	} else
+		m_recorder.Keyboard(tick, m_keyboard);
+
 	switch (m_state) {
 	case State::InGame: InputGame(); break;
 
@@ -535,18 +738,24 @@ void Game::Input() {
 	}
 }
 
+void Game::PumpEvents() {
+	// Events left in SDL when the queue is full are picked up by the next pump
+	while (not m_events.Full() and PollEvent())
+		m_events.Push(m_event);
+}
+
 void Game::InputGame() {
 	if (m_flag.paused)
 		return;
 
 	if (m_keyboard[SDL_SCANCODE_W])
-		world.camera.Up();
+		Submit(Command::PanCamera(Dir::Up));
 	if (m_keyboard[SDL_SCANCODE_A])
-		world.camera.Left();
+		Submit(Command::PanCamera(Dir::Left));
 	if (m_keyboard[SDL_SCANCODE_S])
-		world.camera.Down();
+		Submit(Command::PanCamera(Dir::Down));
 	if (m_keyboard[SDL_SCANCODE_D])
-		world.camera.Right();
+		Submit(Command::PanCamera(Dir::Right));
 }
 
 void Game::EventsGame() {
@@ -558,34 +767,90 @@ void Game::EventsGame() {
 		switch (m_event.key.keysym.sym) {
 		case SDLK_SPACE: m_flag.paused = not m_flag.paused; break;
 
+		case SDLK_1: case SDLK_2: case SDLK_3: case SDLK_4: case SDLK_5:
+			m_brush = static_cast<Tile::Type>(m_event.key.keysym.sym - SDLK_1);
+
+			break;
+
+		case SDLK_b: m_tool = Tool::Brush; break;
+		case SDLK_r: m_tool = Tool::Rect;  break;
+		case SDLK_l: m_tool = Tool::Line;  break;
+		case SDLK_f: m_tool = Tool::Fill;  break;
+
+		// The modifiers of the event itself, the keyboard state is not up to date with it on replays
+		case SDLK_z:
+			if (m_event.key.keysym.mod & KMOD_CTRL)
+				Submit(Command::Undo());
+
+			break;
+
+		case SDLK_y:
+			if (m_event.key.keysym.mod & KMOD_CTRL)
+				Submit(Command::Redo());
+
+			break;
+
 		default: break;
 		}
 
 		break;
 
 	case SDL_MOUSEBUTTONDOWN:
-		if (ui.NoFocus() and m_event.button.button == SDL_BUTTON_RIGHT)
+		if (not ui.NoFocus())
+			break;
+
+		if (m_event.button.button == SDL_BUTTON_RIGHT)
 			m_flag.draggingScreen = true;
+		else if (m_event.button.button == SDL_BUTTON_LEFT) {
+			m_dragTool = m_tool;
+
+			switch (m_dragTool) {
+			case Tool::Brush:
+				m_flag.painting = true;
+				m_paintedTile   = Vec2i(-1);
+
+				// The whole drag is undone at once
+				Submit(Command::BeginEdit());
+				Paint();
+
+				break;
+
+			case Tool::Rect: case Tool::Line:
+				m_flag.painting = true;
+				m_editStart     = HoveredTile();
+
+				break;
+
+			case Tool::Fill: Submit(Command::FloodFill(HoveredTile(), m_brush)); break;
+			}
+		}
 
 		break;
 
 	case SDL_MOUSEBUTTONUP:
-		if (m_flag.draggingScreen)
-			m_flag.draggingScreen = false;
+		if (m_flag.painting) {
+			if (m_dragTool == Tool::Brush)
+				Submit(Command::EndEdit());
+			else
+				EditArea(HoveredTile());
+		}
+
+		m_flag.draggingScreen = false;
+		m_flag.painting       = false;
 
 		break;
 
 	case SDL_MOUSEMOTION:
 		if (m_flag.draggingScreen)
-			world.camera.Move(m_prevMouse - m_mouse);
+			Submit(Command::DragCamera(m_prevMouse - m_mouse));
+		else if (m_flag.painting and m_dragTool == Tool::Brush)
+			Paint();
 
 		break;
 
 	case SDL_MOUSEWHEEL:
-		if (m_event.wheel.y > 0)
-			world.camera.ZoomIn();
-		else if (m_event.wheel.y < 0)
-			world.camera.ZoomOut();
+		if (m_event.wheel.y != 0)
+			Submit(Command::ZoomCamera(m_event.wheel.y > 0? 1 : -1));
 
 		break;
 
@@ -593,37 +858,110 @@ void Game::EventsGame() {
 	}
 }
 
-void Game::Update() {
-	++ tick;
+void Game::Paint() {
+	Vec2i tile = HoveredTile();
+	if (tile == m_paintedTile or not world.Contains(tile))
+		return;
 
-	m_timers.Update();
+	m_paintedTile = tile;
+
+	if (m_keyboard[SDL_SCANCODE_LCTRL] or m_keyboard[SDL_SCANCODE_RCTRL])
+		Submit(Command::Demolish(tile));
+	else
+		Submit(Command::Build(tile, m_brush));
 }
 
-void Game::ResetViewport() {
-	SDL_Rect viewport = m_baseViewport;
-	SDL_RenderSetViewport(renderer, &viewport);
+void Game::EditArea(const Vec2i &p_tile) {
+	if (m_dragTool == Tool::Rect)
+		Submit(Command::FillRect(m_editStart, p_tile, m_brush));
+	else
+		Submit(Command::Line(m_editStart, p_tile, m_brush));
+}
 
-	m_viewport = SCREEN_RECT;
+void Game::Submit(const Command &p_command) {
+	if (not world.commands.Push(p_command)) {
+#ifdef CITY_BUILDER_LOG
+		Log("Command queue is full, dropped a command");
+#endif
+	}
+}
+
+Vec2i Game::HoveredTile() {
+	return Projection(world.Front().camera).TileAt(m_mouse);
 }
 
-void Game::SetViewport(const Rectf &p_viewport) {
-	SDL_Rect viewport = Rectf(p_viewport.Pos() + m_baseViewport.Pos(), p_viewport.Size()).Round();
-	SDL_RenderSetViewport(renderer, &viewport);
+void Game::Update() {
+	PROFILE_ZONE("Game::Update");
+
+	++ tick;
 
-	m_viewport = p_viewport;
+	// The world is all ours until the next tick gets kicked. Input keeps being polled while a
+	// long tick runs
+	while (not m_sim.WaitFor(SIMULATION_POLL_MS))
+		PumpEvents();
+	world.SwapSnapshots();
+	m_minimap.Update(world);
+
+	m_overlay.Tick();
+
+	if (m_bench.Active()) {
+		m_bench.Frame(world.camera, world.VisibleTiles());
+
+		if (m_bench.Done()) {
+			m_bench.Report(std::cout);
+
+			m_flag.quit = true;
+		}
+	}
+
+	// Fades redraw every tick while they are going
+	bool fading = m_timers.Count() > 0;
+
+	m_timers.Update();
+	if (fading)
+		m_flag.redraw = true;
+
+	// Applies the commands from this frame's input while the next frame renders
+	m_sim.Kick();
 }
 
 Vec2i Game::MousePos() {
-	return m_mouse - m_viewport.Pos();
+	return m_mouse;
 }
 
 MouseButton Game::MousePressed() {
 	return m_mouseButton;
 }
 
+int Game::MouseWheel() {
+	return m_mouseWheel;
+}
+
 void Game::SetState(State p_state) {
 	m_state = p_state;
 	ui.ResetFocus();
+
+	m_flag.redraw = true;
+}
+
+bool Game::NeedsRedraw() {
+	// The overlay shows live numbers, so it keeps redrawing
+	const auto &snapshot = world.Front();
+
+	return m_flag.redraw or m_overlay.Visible() or m_timers.Count() > 0 or ui.FocusChanged() or
+	       m_settledWorldVersion != snapshot.version or
+	       m_settledCameraPos != snapshot.camera.pos or m_settledCameraZoom != snapshot.camera.zoom;
+}
+
+void Game::SettleRedraw() {
+	m_flag.redraw = false;
+
+	const auto &snapshot = world.Front();
+
+	m_settledCameraPos    = snapshot.camera.pos;
+	m_settledCameraZoom   = snapshot.camera.zoom;
+	m_settledWorldVersion = snapshot.version;
+	ui.SettleFocus();
 }
 
 bool Game::Paused() {
@@ -634,4 +972,12 @@ bool Game::Quit() {
 	return m_flag.quit;
 }
 
+bool Game::Headless() {
+	return m_flag.headless;
+}
+
+bool Game::Idle() {
+	return not m_flag.headless and not NeedsRedraw();
+}
+
 }
@@ -6,25 +6,35 @@
 #include <utility>  // std::pair, std::get
 #include <cassert>  // assert
 #include <cstring>  // std::memset
+#include <charconv> // std::from_chars
 
 #include <SDL2/SDL.h>
 
 #include "config.hh"
 #include "ui_config.hh"
+#include "replay.hh"
+#include "perf_overlay.hh"
+#include "bench.hh"
+#include "frame_pacer.hh"
+#include "minimap.hh"
 
 #include "../utils.hh"
 #include "../units.hh"
 #include "../math.hh"
 #include "../timer.hh"
+#include "../profiler.hh"
 
 #include "../texture_manager.hh"
 #include "../sheet.hh"
 #include "../ui.hh"
+#include "../draw_list.hh"
+#include "../render_context.hh"
 
 #include "../text/text_renderer.hh"
 #include "../text/font_manager.hh"
 
 #include "../world/world.hh"
+#include "../world/simulation.hh"
 
 #define SCREEN_RECT Recti(0, 0, SCREEN_W, SCREEN_H)
 
@@ -43,7 +53,9 @@ namespace ID {
 		Button_Dialog_Yes,
 		Button_Dialog_No,
 
-		Button_Paused
+		Button_Paused,
+
+		Minimap
 	};
 }
 
@@ -66,29 +78,39 @@ public:
 	void Input();
 	void Update();
 
-	// SDL viewports get messed up with logical size, so we define functions which fix it
-	void ResetViewport();
-	void SetViewport(const Rectf &p_viewport);
+	// Only moves events from SDL into the input queue, cheap enough to call at any point
+	void PumpEvents();
 
 	Vec2i       MousePos();
 	MouseButton MousePressed();
+	// Wheel steps since the last Input(), positive is up
+	int         MouseWheel();
 
 	bool Paused();
 	bool Quit();
+	// Running without a visible window (replaying), frames should not be capped
+	bool Headless();
+	// Nothing on screen would change, so the frame can be skipped
+	bool Idle();
 
 	SDL_Window   *window;
 	SDL_Renderer *renderer;
+	// Draws go through this, so they get counted
+	RenderContext renderContext;
 
 	UI::StyleManager  styles;
 	Text::FontManager fonts;
 	TextureManager    textures;
 	Text::Renderer    textRenderer;
+	DrawList          drawList;
 
 	Sheet tileSheet, buildingSheet;
 	World world;
 
 	UI ui;
 
+	FramePacer pacer;
+
 	size_t tick;
 
 private:
@@ -99,31 +121,31 @@ private:
 		Credits
 	};
 
+	// What dragging with LMB does in the game
+	enum class Tool {
+		Brush = 0,
+		Rect,
+		Line,
+		Fill
+	};
+
 	enum class DialogResponse {
 		None = 0,
 		Yes,
 		No
 	};
 
-	struct Timer {
-		enum Type {
-			FadeOut = 0,
-			FadeIn,
-
-			Count
-		};
-	};
-
 	Game(int p_argc, char **p_argv);
 	~Game();
 
+	void ParseArgs(int p_argc, char **p_argv);
+
 	void LoadTexture(const std::string &p_key, const std::string &p_path);
 	void LoadFont(const std::string &p_key,
 	              const std::string &p_sheetPath, const std::string &p_infoPath);
 
 	void LoadAssets();
 	void InitUIStyles();
-	void InitTimers();
 
 	void RenderGame();
 	void RenderPaused();
@@ -136,24 +158,79 @@ private:
 
 	void RenderDarkenScreen(float p_a);
 
+	// Restart the fade if it is already going
+	void FadeOut();
+	void FadeIn();
+
 	void InputGame();
 	void EventsGame();
 
+	// Builds (or demolishes with ctrl held) on the tile under the mouse, once per tile while
+	// dragging
+	void Paint();
+	// Sends the area edit of the tool, from where the drag started to p_tile
+	void EditArea(const Vec2i &p_tile);
+	void Submit(const Command &p_command);
+
+	// Under the mouse, picked with the camera that is on the screen
+	Vec2i HoveredTile();
+
+	// Polls from SDL or the replay log, events from SDL get recorded
+	bool PollEvent();
+
 	DialogResponse UIDialog(const std::string &p_text);
 
 	void SetState(State p_state);
 
+	bool NeedsRedraw();
+	void SettleRedraw();
+
 	SDL_Event      m_event;
 	const uint8_t *m_keyboard;
 	Vec2i          m_mouse, m_prevMouse;
 	MouseButton    m_mouseButton;
+	int            m_mouseWheel;
 
-	Recti m_baseViewport, m_viewport;
+	SPSCQueue<SDL_Event, INPUT_QUEUE_SIZE> m_events;
+
+	// The tool is latched when a drag starts, so switching tools mid-drag does not mix them up
+	Tool       m_tool, m_dragTool;
+	Tile::Type m_brush;
+	Vec2i      m_paintedTile, m_editStart;
 
 	State m_state;
 	Menu  m_menu;
 
-	TimerHandler<Timer::Count> m_timers;
+	// Resolved once after loading, so rendering does not look resources up by name every frame
+	struct {
+		Handle<UI::Style> blackScreen, overlay, dialog, list, menu;
+	} m_styles;
+
+	struct {
+		Handle<Texture> logo, backButton;
+	} m_textures;
+
+	Simulation m_sim;
+
+	Vec2f  m_settledCameraPos;
+	float  m_settledCameraZoom;
+	size_t m_settledWorldVersion;
+
+	TimerWheel m_timers;
+
+	struct {
+		TimerWheel::ID out, in;
+	} m_fade;
+
+	std::string   m_recordPath, m_replayPath;
+	InputRecorder m_recorder;
+	InputReplayer m_replayer;
+
+	PerfOverlay m_overlay;
+	Minimap     m_minimap;
+
+	Benchmark m_bench;
+	size_t    m_benchSize, m_benchFrames;
 
 #define NEW_FLAG(P_NAME) unsigned P_NAME: 1
 
@@ -164,6 +241,12 @@ private:
 		NEW_FLAG(quitDialog);
 		NEW_FLAG(disableUI);
 		NEW_FLAG(draggingScreen);
+		NEW_FLAG(painting);
+
+		NEW_FLAG(headless);
+		NEW_FLAG(redraw);
+		NEW_FLAG(vsync);
+		NEW_FLAG(bench);
 	} m_flag;
 
 	static Game *m_instance;
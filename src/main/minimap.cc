@@ -0,0 +1,112 @@
+#include "minimap.hh"
+
+#include "game.hh"
+
+namespace CityBuilder {
+
+// ARGB, indexed by Tile::Type
+static const uint32_t tileColors[] = {
+	0xFF4C9A3C, // Grass
+	0xFF8A6238, // Dirt
+	0xFFD8C47A, // Sand
+	0xFF7C7C80, // Stone
+	0xFF3A6FC4, // Water
+};
+
+static_assert(sizeof(tileColors) / sizeof(tileColors[0]) == Tile::Count,
+              "Every tile type needs a minimap color");
+
+void Minimap::Update(World &p_world) {
+	PROFILE_ZONE("Minimap::Update");
+
+	// Recreated whenever the world gets resized, every chunk is uploaded then
+	if (m_texture == nullptr or m_size != p_world.size) {
+		m_texture.reset();
+		m_size = p_world.size;
+
+		SDL_Texture *raw = SDL_CreateTexture(Game::Get().renderer, SDL_PIXELFORMAT_ARGB8888,
+		                                     SDL_TEXTUREACCESS_STREAMING, m_size.x, m_size.y);
+		if (raw == nullptr)
+			Panic("Failed to create the minimap texture: ", SDL_GetError());
+
+		m_texture = std::make_unique<Texture>(raw);
+
+		for (int32_t y = 0; y < m_size.y; y += WORLD_CHUNK_SIZE) {
+			for (int32_t x = 0; x < m_size.x; x += WORLD_CHUNK_SIZE)
+				Upload(p_world, Vec2i(x / WORLD_CHUNK_SIZE, y / WORLD_CHUNK_SIZE));
+		}
+	} else {
+		for (const auto &chunk : p_world.DirtyChunks())
+			Upload(p_world, chunk);
+	}
+
+	p_world.ClearDirtyChunks();
+}
+
+bool Minimap::Render(UI &p_ui, UI::ID p_id, const World::Snapshot &p_snapshot, Vec2f &p_pos) {
+	PROFILE_ZONE("Minimap::Render");
+
+	if (m_texture == nullptr or p_snapshot.size.x + p_snapshot.size.y == 0)
+		return false;
+
+	// Tile space point (u, v) is at ((u - v) * TILE_W / 2 + TILE_W / 2, (u + v) * TILE_H / 2) in
+	// world pixels, so the world diamond spans this box
+	Vec2f size = static_cast<Vec2f>(p_snapshot.size);
+	Vec2f box((size.x + size.y) * TILE_W / 2, (size.x + size.y) * TILE_H / 2);
+	Vec2f boxPos((1 - size.y) * TILE_W / 2, 0);
+
+	float scale = std::min(UI_MINIMAP_W / box.x, UI_MINIMAP_H / box.y);
+	Vec2f center((UI_MINIMAP_W - box.x * scale) / 2, (UI_MINIMAP_H - box.y * scale) / 2);
+
+	auto toMinimap = [&](float p_u, float p_v) {
+		Vec2f world((p_u - p_v) * TILE_W / 2 + TILE_W / 2, (p_u + p_v) * TILE_H / 2);
+
+		return (world - boxPos) * scale + center;
+	};
+
+	Vec2f corners[] = {
+		toMinimap(0, 0), toMinimap(size.x, 0), toMinimap(size.x, size.y), toMinimap(0, size.y)
+	};
+
+	// The screen is centered on the camera position, offset by half a tile like the projection
+	const Camera &camera = p_snapshot.camera;
+
+	Vec2f view(SCREEN_W / camera.zoom, SCREEN_H / camera.zoom);
+	Vec2f viewPos(camera.pos.x + TILE_W / 2 - view.x / 2, camera.pos.y - view.y / 2);
+	Rectf mark((viewPos - boxPos) * scale + center, view * scale);
+
+	Vec2f mouse;
+
+	p_ui.Begin(UI_MINIMAP_POS);
+	bool held = p_ui.Minimap(p_id, *m_texture, UI_MINIMAP_SIZE, corners, mark, mouse);
+	p_ui.End();
+
+	if (not held)
+		return false;
+
+	Vec2f world = (mouse - center) / scale + boxPos;
+	p_pos = Vec2f(world.x - TILE_W / 2, world.y);
+
+	return true;
+}
+
+void Minimap::Clear() {
+	m_texture.reset();
+}
+
+void Minimap::Upload(const World &p_world, const Vec2i &p_chunk) {
+	Recti rect = p_world.ChunkRect(p_chunk);
+
+	for (int32_t y = 0; y < rect.h; ++ y) {
+		const World::Row &row = p_world.tiles[rect.y + y];
+
+		for (int32_t x = 0; x < rect.w; ++ x)
+			m_pixels[y * rect.w + x] = tileColors[row[rect.x + x].type];
+	}
+
+	SDL_Rect dest = rect;
+	if (SDL_UpdateTexture(m_texture->raw, &dest, m_pixels.data(), rect.w * sizeof(uint32_t)) != 0)
+		Panic("Failed to update the minimap texture: ", SDL_GetError());
+}
+
+}
@@ -0,0 +1,44 @@
+#ifndef MINIMAP_HH__HEADER_GUARD__
+#define MINIMAP_HH__HEADER_GUARD__
+
+#include <array>     // std::array
+#include <memory>    // std::unique_ptr
+#include <algorithm> // std::min
+
+#include <SDL2/SDL.h>
+
+#include "../utils.hh"
+#include "../texture.hh"
+#include "../ui.hh"
+
+#include "../world/world.hh"
+
+namespace CityBuilder {
+
+// One pixel per tile, kept in a streaming texture which is stretched into the world diamond.
+// Only the chunks the world marked dirty get uploaded again, so it costs nothing while the
+// world does not change
+class Minimap {
+public:
+	// Has to be called while the simulation is not ticking, uploads the dirty chunks
+	void Update(World &p_world);
+
+	// Returns whether a place on the minimap was clicked (or dragged over), p_pos is then the
+	// camera position that centers it
+	bool Render(UI &p_ui, UI::ID p_id, const World::Snapshot &p_snapshot, Vec2f &p_pos);
+
+	// Frees the texture, has to be called before the renderer is destroyed
+	void Clear();
+
+private:
+	void Upload(const World &p_world, const Vec2i &p_chunk);
+
+	std::unique_ptr<Texture> m_texture;
+	Vec2i                    m_size;
+
+	std::array<uint32_t, WORLD_CHUNK_SIZE * WORLD_CHUNK_SIZE> m_pixels;
+};
+
+}
+
+#endif
@@ -0,0 +1,130 @@
+#include "perf_overlay.hh"
+
+#include "game.hh"
+
+namespace CityBuilder {
+
+// One decimal is enough to read, and keeps the labels from jumping around
+static float Round1(float p_n) {
+	return std::round(p_n * 10) / 10;
+}
+
+PerfOverlay::PerfOverlay():
+	m_head(0),
+	m_count(0),
+
+	m_prevCounter(0),
+	m_rateStart(0),
+	m_ticks(0),
+	m_tickRate(0),
+	m_textHitRate(0),
+
+	m_visible(false)
+{}
+
+void PerfOverlay::Toggle() {
+	m_visible = not m_visible;
+}
+
+bool PerfOverlay::Visible() const {
+	return m_visible;
+}
+
+void PerfOverlay::Tick() {
+	uint64_t counter   = SDL_GetPerformanceCounter();
+	double   frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+
+	if (m_prevCounter != 0) {
+		m_frameTimes[m_head] = (counter - m_prevCounter) * 1000 / frequency;
+
+		m_head = (m_head + 1) % m_frameTimes.size();
+		if (m_count < m_frameTimes.size())
+			++ m_count;
+	} else
+		m_rateStart = counter;
+
+	m_prevCounter = counter;
+	++ m_ticks;
+
+	double elapsed = (counter - m_rateStart) * 1000 / frequency;
+	if (elapsed < PERF_OVERLAY_RATE_MS)
+		return;
+
+	m_tickRate  = m_ticks * 1000 / elapsed;
+	m_ticks     = 0;
+	m_rateStart = counter;
+
+	Text::Renderer &textRenderer = Game::Get().textRenderer;
+
+	const auto &stats   = textRenderer.GetStats();
+	size_t      lookups = stats.hits + stats.misses;
+	m_textHitRate = lookups == 0? 100 : static_cast<float>(stats.hits) * 100 / lookups;
+
+	textRenderer.ResetStats();
+}
+
+void PerfOverlay::Render(UI &p_ui) {
+	PROFILE_ZONE("PerfOverlay::Render");
+
+	// Oldest first, so the graph scrolls to the left
+	std::array<float, PERF_OVERLAY_HISTORY> frames;
+	size_t oldest = (m_head + m_frameTimes.size() - m_count) % m_frameTimes.size();
+	for (size_t i = 0; i < m_count; ++ i)
+		frames[i] = m_frameTimes[(oldest + i) % m_frameTimes.size()];
+
+	std::copy(frames.begin(), frames.begin() + m_count, m_sorted.begin());
+	std::sort(m_sorted.begin(), m_sorted.begin() + m_count);
+
+	float last = m_count > 0? frames[m_count - 1] : 0;
+	float max  = m_count > 0? m_sorted[m_count - 1] : 0;
+
+	Game &game = Game::Get();
+
+	const auto &renderStats = game.renderContext.GetStats();
+	const auto &drawStats   = game.drawList.GetStats();
+	size_t      tiles       = static_cast<size_t>(game.world.size.x) * game.world.size.y;
+
+	p_ui.Begin(UI_OVERLAY_POS, UI::Layout::Vert);
+	{
+		p_ui.TextLabel(String("Frame ", Round1(last), "ms, max ", Round1(max), "ms"),
+		               UI_OVERLAY_TEXT_SCALE);
+		p_ui.TextLabel(String("p50 ", Round1(Percentile(50)), " p95 ", Round1(Percentile(95)),
+		                      " p99 ", Round1(Percentile(99))), UI_OVERLAY_TEXT_SCALE);
+		p_ui.TextLabel(String("Pacing ", FramePacer::ModeName(game.pacer.GetMode()), ", jitter ",
+		                      Round1(game.pacer.Jitter()), "ms"), UI_OVERLAY_TEXT_SCALE);
+
+		// The line marks the frame budget
+		p_ui.Graph(frames.data(), m_count, std::max(max, 1000.0f / FPS_CAP * 2),
+		           UI_OVERLAY_GRAPH_SIZE, 1000.0f / FPS_CAP);
+
+		p_ui.TextLabel(String("Draws ", renderStats.drawCalls, ", binds ", renderStats.textureBinds,
+		                      ", colors ", renderStats.colorChanges), UI_OVERLAY_TEXT_SCALE);
+		p_ui.TextLabel(String("Draw list ", drawStats.batches, " batches, ",
+		                      drawStats.textureSwitches, " textures"), UI_OVERLAY_TEXT_SCALE);
+		p_ui.TextLabel(String("Text cache ", Round1(m_textHitRate), "% hits"),
+		               UI_OVERLAY_TEXT_SCALE);
+		p_ui.TextLabel(String("Tiles ", game.world.VisibleTiles(), "/", tiles, " visible"),
+		               UI_OVERLAY_TEXT_SCALE);
+		p_ui.TextLabel(String("Ticks ", Round1(m_tickRate), "/s"), UI_OVERLAY_TEXT_SCALE);
+
+		for (size_t i = 0; i < Memory::Count; ++ i) {
+			auto          tag   = static_cast<Memory::Tag>(i);
+			Memory::Usage usage = Memory::Get(tag);
+
+			p_ui.TextLabel(String("Mem ", Memory::Name(tag), " ", usage.current / 1024, "K, peak ",
+			                      usage.peak / 1024, "K"), UI_OVERLAY_TEXT_SCALE);
+		}
+	}
+	p_ui.End();
+}
+
+float PerfOverlay::Percentile(float p_percent) const {
+	if (m_count == 0)
+		return 0;
+
+	size_t idx = static_cast<size_t>(std::round((m_count - 1) * p_percent / 100));
+
+	return m_sorted[idx];
+}
+
+}
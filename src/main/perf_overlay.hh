@@ -0,0 +1,50 @@
+#ifndef PERF_OVERLAY_HH__HEADER_GUARD__
+#define PERF_OVERLAY_HH__HEADER_GUARD__
+
+#include <array>     // std::array
+#include <algorithm> // std::sort, std::max
+#include <cmath>     // std::round
+
+#include <SDL2/SDL.h>
+
+#include "../utils.hh"
+#include "../ui.hh"
+
+// Frames kept for the graph and the percentiles
+#define PERF_OVERLAY_HISTORY 130
+
+// How often the rates (ticks, text cache hits) are sampled
+#define PERF_OVERLAY_RATE_MS 1000
+
+namespace CityBuilder {
+
+// Live frame statistics drawn with the UI, always compiled in so slowdowns can be looked into
+// without a profiler. Frames are measured even while hidden, so the graph is full when shown
+class PerfOverlay {
+public:
+	PerfOverlay();
+
+	void Toggle();
+	bool Visible() const;
+
+	// Has to be called once every simulation tick
+	void Tick();
+
+	void Render(UI &p_ui);
+
+private:
+	float Percentile(float p_percent) const;
+
+	std::array<float, PERF_OVERLAY_HISTORY> m_frameTimes, m_sorted; // Milliseconds
+	size_t m_head, m_count;
+
+	uint64_t m_prevCounter, m_rateStart;
+	size_t   m_ticks;
+	float    m_tickRate, m_textHitRate;
+
+	bool m_visible;
+};
+
+}
+
+#endif
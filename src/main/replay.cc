@@ -0,0 +1,336 @@
+#include "replay.hh"
+
+namespace CityBuilder {
+
+InputRecorder::InputRecorder():
+	m_tick(0)
+{
+	std::memset(m_keyboard, 0, sizeof(m_keyboard));
+}
+
+InputRecorder::~InputRecorder() {
+	Close();
+}
+
+Error InputRecorder::Open(const std::string &p_path) {
+	m_file.open(p_path, std::ios::binary | std::ios::trunc);
+	if (not m_file.is_open())
+		return Error::Make("Failed to open replay file '", p_path, "'");
+
+	uint32_t header[2] = {REPLAY_MAGIC, REPLAY_VERSION};
+	m_buffer.append(reinterpret_cast<const char*>(header), sizeof(header));
+
+	return Error::Fine();
+}
+
+void InputRecorder::Close() {
+	if (not Active())
+		return;
+
+	Flush();
+	m_file.close();
+}
+
+bool InputRecorder::Active() const {
+	return m_file.is_open();
+}
+
+void InputRecorder::Event(size_t p_tick, const SDL_Event &p_event) {
+	if (not Active())
+		return;
+
+	switch (p_event.type) {
+	case SDL_QUIT:
+		Begin(p_tick, Replay::Event);
+		Varint(p_event.type);
+
+		break;
+
+	case SDL_WINDOWEVENT:
+		Begin(p_tick, Replay::Event);
+		Varint(p_event.type);
+		Byte(p_event.window.event);
+		Signed(p_event.window.data1);
+		Signed(p_event.window.data2);
+
+		break;
+
+	case SDL_MOUSEMOTION:
+		Begin(p_tick, Replay::Event);
+		Varint(p_event.type);
+		Signed(p_event.motion.x - m_mouse.x);
+		Signed(p_event.motion.y - m_mouse.y);
+
+		m_mouse = Vec2i(p_event.motion.x, p_event.motion.y);
+
+		break;
+
+	case SDL_MOUSEBUTTONDOWN: case SDL_MOUSEBUTTONUP:
+		Begin(p_tick, Replay::Event);
+		Varint(p_event.type);
+		Byte(p_event.button.button);
+
+		break;
+
+	case SDL_MOUSEWHEEL:
+		Begin(p_tick, Replay::Event);
+		Varint(p_event.type);
+		Signed(p_event.wheel.x);
+		Signed(p_event.wheel.y);
+
+		break;
+
+	case SDL_KEYDOWN: case SDL_KEYUP:
+		Begin(p_tick, Replay::Event);
+		Varint(p_event.type);
+		Varint(p_event.key.keysym.scancode);
+		Varint(static_cast<uint32_t>(p_event.key.keysym.sym));
+		Varint(p_event.key.keysym.mod);
+		Byte(p_event.key.repeat);
+
+		break;
+
+	// Game::Input ignores everything else
+	default: break;
+	}
+
+	if (m_buffer.size() >= REPLAY_FLUSH_SIZE)
+		Flush();
+}
+
+void InputRecorder::Keyboard(size_t p_tick, const uint8_t *p_keyboard) {
+	if (not Active())
+		return;
+
+	size_t changed = 0;
+	for (size_t i = 0; i < SDL_NUM_SCANCODES; ++ i)
+		changed += m_keyboard[i] != p_keyboard[i];
+
+	if (changed == 0)
+		return;
+
+	Begin(p_tick, Replay::Keyboard);
+	Varint(changed);
+
+	for (size_t i = 0; i < SDL_NUM_SCANCODES; ++ i) {
+		if (m_keyboard[i] != p_keyboard[i]) {
+			Varint(i);
+
+			m_keyboard[i] = p_keyboard[i];
+		}
+	}
+}
+
+void InputRecorder::Begin(size_t p_tick, Replay::Record p_kind) {
+	Varint(p_tick - m_tick);
+	Byte(p_kind);
+
+	m_tick = p_tick;
+}
+
+void InputRecorder::Byte(uint8_t p_byte) {
+	m_buffer += static_cast<char>(p_byte);
+}
+
+void InputRecorder::Varint(uint64_t p_value) {
+	while (p_value >= 0x80) {
+		Byte(static_cast<uint8_t>(p_value | 0x80));
+
+		p_value >>= 7;
+	}
+
+	Byte(static_cast<uint8_t>(p_value));
+}
+
+void InputRecorder::Signed(int64_t p_value) {
+	// Zigzag, so small negative deltas stay small
+	Varint((static_cast<uint64_t>(p_value) << 1) ^ static_cast<uint64_t>(p_value >> 63));
+}
+
+void InputRecorder::Flush() {
+	m_file.write(m_buffer.data(), m_buffer.size());
+	m_buffer.clear();
+}
+
+InputReplayer::InputReplayer():
+	m_pos(0),
+	m_next(0),
+
+	m_active(false),
+	m_tick(0)
+{
+	std::memset(m_keyboard, 0, sizeof(m_keyboard));
+}
+
+Error InputReplayer::Open(const std::string &p_path) {
+	auto log = ReadFile(p_path);
+	if (not log.Ok())
+		return Error::Make(log.Desc());
+
+	m_log = std::move(log.Value());
+
+	uint32_t header[2];
+	if (m_log.size() < sizeof(header))
+		return Error::Make("Replay file '", p_path, "' is truncated");
+
+	std::memcpy(header, m_log.data(), sizeof(header));
+	if (header[0] != REPLAY_MAGIC)
+		return Error::Make("'", p_path, "' is not a replay file");
+	else if (header[1] != REPLAY_VERSION)
+		return Error::Make("Replay file '", p_path, "' has unsupported version ", header[1]);
+
+	m_pos    = sizeof(header);
+	m_active = true;
+
+	return Error::Fine();
+}
+
+bool InputReplayer::Active() const {
+	return m_active;
+}
+
+bool InputReplayer::Done() const {
+	return m_pos >= m_log.size();
+}
+
+bool InputReplayer::PollEvent(size_t p_tick, SDL_Event &p_event) {
+	size_t         tick;
+	Replay::Record kind;
+
+	// Records are taken in the order they were written. Ones of earlier ticks (a missed tick or a
+	// damaged log) are taken too, so they can not hold up the rest of the log
+	while (true) {
+		if (not Peek(tick, kind) or tick > p_tick)
+			return false;
+
+		Consume();
+		m_tick = tick;
+
+		if (kind == Replay::Event)
+			break;
+
+		ReadKeyboard();
+	}
+
+	std::memset(&p_event, 0, sizeof(p_event));
+	p_event.type = static_cast<uint32_t>(Varint());
+
+	switch (p_event.type) {
+	case SDL_QUIT: break;
+
+	case SDL_WINDOWEVENT:
+		p_event.window.event = Byte();
+		p_event.window.data1 = static_cast<int32_t>(Signed());
+		p_event.window.data2 = static_cast<int32_t>(Signed());
+
+		break;
+
+	case SDL_MOUSEMOTION:
+		p_event.motion.xrel = static_cast<int32_t>(Signed());
+		p_event.motion.yrel = static_cast<int32_t>(Signed());
+
+		m_mouse += Vec2i(p_event.motion.xrel, p_event.motion.yrel);
+
+		p_event.motion.x = m_mouse.x;
+		p_event.motion.y = m_mouse.y;
+
+		break;
+
+	case SDL_MOUSEBUTTONDOWN: case SDL_MOUSEBUTTONUP:
+		p_event.button.button = Byte();
+		p_event.button.x      = m_mouse.x;
+		p_event.button.y      = m_mouse.y;
+
+		break;
+
+	case SDL_MOUSEWHEEL:
+		p_event.wheel.x = static_cast<int32_t>(Signed());
+		p_event.wheel.y = static_cast<int32_t>(Signed());
+
+		break;
+
+	case SDL_KEYDOWN: case SDL_KEYUP:
+		p_event.key.keysym.scancode = static_cast<SDL_Scancode>(Varint());
+		p_event.key.keysym.sym      = static_cast<SDL_Keycode>(Varint());
+		p_event.key.keysym.mod      = static_cast<uint16_t>(Varint());
+		p_event.key.repeat          = Byte();
+
+		break;
+
+	default: Panic("Replay: Unknown event type ", p_event.type, " in the log");
+	}
+
+	return true;
+}
+
+void InputReplayer::UpdateKeyboard(size_t p_tick) {
+	size_t         tick;
+	Replay::Record kind;
+	while (Peek(tick, kind) and tick <= p_tick and kind == Replay::Keyboard) {
+		Consume();
+		m_tick = tick;
+
+		ReadKeyboard();
+	}
+}
+
+const uint8_t *InputReplayer::Keyboard() const {
+	return m_keyboard;
+}
+
+bool InputReplayer::Peek(size_t &p_tick, Replay::Record &p_kind) {
+	if (Done())
+		return false;
+
+	size_t pos = m_pos;
+
+	p_tick = m_tick + Varint();
+	p_kind = static_cast<Replay::Record>(Byte());
+
+	m_next = m_pos;
+	m_pos  = pos;
+
+	return true;
+}
+
+void InputReplayer::Consume() {
+	m_pos = m_next;
+}
+
+void InputReplayer::ReadKeyboard() {
+	for (size_t count = Varint(); count > 0; -- count) {
+		uint64_t scancode = Varint();
+		if (scancode >= SDL_NUM_SCANCODES)
+			Panic("Replay: Scancode ", scancode, " out of range");
+
+		m_keyboard[scancode] = not m_keyboard[scancode];
+	}
+}
+
+uint8_t InputReplayer::Byte() {
+	if (Done())
+		Panic("Replay: Unexpected end of the log");
+
+	return static_cast<uint8_t>(m_log[m_pos ++]);
+}
+
+uint64_t InputReplayer::Varint() {
+	uint64_t value = 0;
+	for (size_t shift = 0; shift < 64; shift += 7) {
+		uint8_t byte = Byte();
+		value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+		if ((byte & 0x80) == 0)
+			break;
+	}
+
+	return value;
+}
+
+int64_t InputReplayer::Signed() {
+	uint64_t value = Varint();
+
+	return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+}
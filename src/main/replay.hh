@@ -0,0 +1,109 @@
+#ifndef REPLAY_HH__HEADER_GUARD__
+#define REPLAY_HH__HEADER_GUARD__
+
+#include <string>  // std::string
+#include <fstream> // std::ofstream
+#include <cstring> // std::memset, std::memcpy
+
+#include <SDL2/SDL.h>
+
+#include "../utils.hh"
+#include "../units.hh"
+#include "../file.hh"
+
+#define REPLAY_MAGIC      0x50524243 // "CBRP"
+#define REPLAY_VERSION    1
+#define REPLAY_FLUSH_SIZE (64 * 1024)
+
+namespace CityBuilder {
+
+// Replay log layout: magic and version (u32 each), then records of
+//   varint tick delta, u8 kind, payload
+// Event payload is the varint event type followed by the fields Game::Input reads, mouse
+// positions are stored as zigzag deltas from the previous position. Keyboard payload is a varint
+// count followed by the scancodes whose state flipped since the previous sample.
+namespace Replay {
+	enum Record : uint8_t {
+		Event = 0,
+		Keyboard
+	};
+}
+
+class InputRecorder {
+public:
+	InputRecorder();
+	~InputRecorder();
+
+	InputRecorder(const InputRecorder &p_copy) = delete;
+	InputRecorder(InputRecorder &&p_move)      = delete;
+
+	Error Open(const std::string &p_path);
+	void  Close();
+
+	bool Active() const;
+
+	void Event(size_t p_tick, const SDL_Event &p_event);
+	// Samples the keyboard state, only the keys that changed since the last sample are written
+	void Keyboard(size_t p_tick, const uint8_t *p_keyboard);
+
+private:
+	void Begin(size_t p_tick, Replay::Record p_kind);
+	void Byte(uint8_t p_byte);
+	void Varint(uint64_t p_value);
+	void Signed(int64_t p_value);
+
+	void Flush();
+
+	std::ofstream m_file;
+	std::string   m_buffer;
+
+	size_t  m_tick;
+	Vec2i   m_mouse;
+	uint8_t m_keyboard[SDL_NUM_SCANCODES];
+};
+
+class InputReplayer {
+public:
+	InputReplayer();
+
+	InputReplayer(const InputReplayer &p_copy) = delete;
+	InputReplayer(InputReplayer &&p_move)      = delete;
+
+	Error Open(const std::string &p_path);
+
+	bool Active() const;
+	bool Done()   const;
+
+	// Gives the next event recorded at p_tick (or before it), false once there are none left for
+	// it. Keyboard changes recorded before the event are applied on the way
+	bool PollEvent(size_t p_tick, SDL_Event &p_event);
+	// Applies the keyboard changes recorded at p_tick (or before it) that come next in the log
+	void UpdateKeyboard(size_t p_tick);
+
+	const uint8_t *Keyboard() const;
+
+private:
+	// Reads the header of the next record (tick and kind), but does not consume it
+	bool Peek(size_t &p_tick, Replay::Record &p_kind);
+	void Consume();
+
+	// Payload of a keyboard record
+	void ReadKeyboard();
+
+	uint8_t  Byte();
+	uint64_t Varint();
+	int64_t  Signed();
+
+	std::string m_log;
+	size_t      m_pos, m_next;
+
+	bool   m_active;
+	size_t m_tick;
+	Vec2i  m_mouse;
+
+	uint8_t m_keyboard[SDL_NUM_SCANCODES];
+};
+
+}
+
+#endif
@@ -97,6 +97,31 @@ namespace CityBuilder {
 
 #define UI_CREDITS_TITLE_TEXT "Credits"
 
+// UI performance overlay
+
+#define UI_OVERLAY_TEXT_SCALE 0.7
+#define UI_OVERLAY_PADDING    2
+
+#define UI_OVERLAY_W    130
+#define UI_OVERLAY_X    (SCREEN_W - UI_OVERLAY_W - UI_OVERLAY_PADDING)
+#define UI_OVERLAY_Y    UI_OVERLAY_PADDING
+#define UI_OVERLAY_POS  Vec2f(UI_OVERLAY_X, UI_OVERLAY_Y)
+
+#define UI_OVERLAY_GRAPH_H    30
+#define UI_OVERLAY_GRAPH_SIZE Vec2f(UI_OVERLAY_W, UI_OVERLAY_GRAPH_H)
+
+// UI minimap
+
+#define UI_MINIMAP_PADDING 4
+
+#define UI_MINIMAP_W    96
+#define UI_MINIMAP_H    48
+#define UI_MINIMAP_SIZE Vec2f(UI_MINIMAP_W, UI_MINIMAP_H)
+
+#define UI_MINIMAP_X   (SCREEN_W - UI_MINIMAP_W - UI_MINIMAP_PADDING)
+#define UI_MINIMAP_Y   (SCREEN_H - UI_MINIMAP_H - UI_MINIMAP_PADDING)
+#define UI_MINIMAP_POS Vec2f(UI_MINIMAP_X, UI_MINIMAP_Y)
+
 // UI dialog
 
 #define UI_DIALOG_PADDING         6
@@ -1,35 +1,115 @@
 #ifndef MANAGER_HH__HEADER_GUARD__
 #define MANAGER_HH__HEADER_GUARD__
 
-#include <unordered_map> // std::unordered_map
+#include <map>         // std::map
+#include <deque>       // std::deque
+#include <functional>  // std::less
+#include <limits>      // std::numeric_limits
+#include <cassert>     // assert
+#include <string_view> // std::string_view
 
 #include "utils.hh"
 
 namespace CityBuilder {
 
 template<typename T, typename Key>
+class Manager;
+
+// Index into a Manager, resolved once from a key so hot paths dont hash strings every frame.
+// Typed by the resource, so a texture handle can not be used to get a style
+template<typename T>
+class Handle {
+public:
+	Handle(): m_idx(std::numeric_limits<uint32_t>::max()) {}
+
+	bool Valid() const {
+		return m_idx != std::numeric_limits<uint32_t>::max();
+	}
+
+	bool operator ==(const Handle &p_handle) const {
+		return m_idx == p_handle.m_idx;
+	}
+
+	bool operator !=(const Handle &p_handle) const {
+		return m_idx != p_handle.m_idx;
+	}
+
+private:
+	template<typename, typename>
+	friend class Manager;
+
+	explicit Handle(uint32_t p_idx): m_idx(p_idx) {}
+
+	uint32_t m_idx;
+};
+
+// Resources are stored densely in insertion order. A deque is used so references given out
+// (styles keep pointers to textures and fonts) stay valid as more resources get added
+template<typename T, typename Key = std::string>
 class Manager {
 public:
-	T &Get(const Key &p_key) {
-		try {
-			return m_library.at(p_key);
-		} catch (...) {
-			Panic("Manager: Attempted to Get() non-existant key '", p_key, "'");
-		}
+	using Handle = CityBuilder::Handle<T>;
+
+	T &Get(Handle p_handle) {
+		assert(p_handle.Valid() and p_handle.m_idx < m_items.size());
 
-		SILENCE_RETURN_WARNING();
+		return m_items[p_handle.m_idx];
+	}
+
+	// Key lookups are transparent, so a std::string_view or a literal works without building a
+	// temporary Key. Prefer interning once and keeping the handle
+	template<typename K>
+	T &Get(const K &p_key) {
+		return Get(Intern(p_key));
+	}
+
+	template<typename K>
+	Handle Intern(const K &p_key) const {
+		auto it = m_index.find(p_key);
+		if (it == m_index.end())
+			Panic("Manager: Attempted to Intern() non-existant key '", p_key, "'");
+
+		return it->second;
+	}
+
+	template<typename K>
+	Maybe<Handle> Find(const K &p_key) const {
+		auto it = m_index.find(p_key);
+		if (it == m_index.end())
+			return Maybe<Handle>::None();
+
+		return it->second;
+	}
+
+	size_t Count() const {
+		return m_items.size();
 	}
 
 protected:
-	void _Add(const Key &p_key, T &&p_val) {
-		m_library.emplace(p_key, std::move(p_val));
+	// Adding an existing key keeps the old resource, same as emplace into a map would
+	Handle _Add(const Key &p_key, T &&p_val) {
+		auto it = m_index.find(p_key);
+		if (it != m_index.end())
+			return it->second;
+
+		Handle handle(static_cast<uint32_t>(m_items.size()));
+		m_items.push_back(std::move(p_val));
+		m_index.emplace(p_key, handle);
+
+		return handle;
+	}
+
+	Handle _Add(const Key &p_key, const T &p_val) {
+		return _Add(p_key, T(p_val));
 	}
 
-	void _Add(const Key &p_key, const T &p_val) {
-		m_library.emplace(p_key, p_val);
+	void _Clear() {
+		m_index.clear();
+		m_items.clear();
 	}
 
-	std::unordered_map<Key, T> m_library;
+	std::deque<T>                          m_items;
+	std::map<Key, Handle, std::less<void>> m_index;
 };
 
 }
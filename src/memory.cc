@@ -0,0 +1,51 @@
+#include "memory.hh"
+
+#include <atomic> // std::atomic
+
+namespace CityBuilder {
+
+namespace Memory {
+	// Atomic, so threads can allocate in the same subsystem
+	static std::atomic<size_t> g_current[Count], g_peak[Count];
+
+	static const char *g_names[Count] = {
+		"world",
+		"text cache",
+		"UI",
+		"draw list",
+		"textures",
+		"journal"
+	};
+
+	void Allocated(Tag p_tag, size_t p_bytes) {
+		size_t current = g_current[p_tag].fetch_add(p_bytes) + p_bytes;
+		size_t peak    = g_peak[p_tag].load();
+
+		// A failed exchange reloads the peak, so this only loops while another thread raced us
+		while (current > peak and not g_peak[p_tag].compare_exchange_weak(peak, current)) {}
+	}
+
+	void Freed(Tag p_tag, size_t p_bytes) {
+		g_current[p_tag].fetch_sub(p_bytes);
+	}
+
+	Usage Get(Tag p_tag) {
+		return Usage{g_current[p_tag].load(), g_peak[p_tag].load()};
+	}
+
+	const char *Name(Tag p_tag) {
+		return g_names[p_tag];
+	}
+
+#ifdef CITY_BUILDER_LOG
+	void LogUsage() {
+		for (size_t i = 0; i < Count; ++ i) {
+			Usage usage = Get(static_cast<Tag>(i));
+
+			Log("Memory ", g_names[i], ": ", usage.current, " bytes, ", usage.peak, " bytes peak");
+		}
+	}
+#endif
+}
+
+}
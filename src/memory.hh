@@ -0,0 +1,95 @@
+#ifndef MEMORY_HH__HEADER_GUARD__
+#define MEMORY_HH__HEADER_GUARD__
+
+#include <new>    // operator new, operator delete
+#include <vector> // std::vector
+#include <list>   // std::list
+#include <deque>  // std::deque
+#include <string> // std::basic_string, std::char_traits
+
+#include "utils.hh"
+
+namespace CityBuilder {
+
+// Heap usage per subsystem. Containers get counted by using TrackingAllocator, textures report
+// an estimate from their size and pixel format
+namespace Memory {
+	enum Tag : uint8_t {
+		World = 0,
+		TextCache,
+		UI,
+		DrawList,
+		Textures,
+		Journal,
+
+		Count
+	};
+
+	struct Usage {
+		size_t current, peak;
+	};
+
+	void Allocated(Tag p_tag, size_t p_bytes);
+	void Freed(Tag p_tag, size_t p_bytes);
+
+	Usage       Get(Tag p_tag);
+	const char *Name(Tag p_tag);
+
+#ifdef CITY_BUILDER_LOG
+	void LogUsage();
+#endif
+}
+
+template<typename T, Memory::Tag Tag>
+struct TrackingAllocator {
+	using value_type = T;
+
+	// Needed explicitly, the standard rebind only works for allocators with type parameters
+	template<typename U>
+	struct rebind {
+		using other = TrackingAllocator<U, Tag>;
+	};
+
+	TrackingAllocator() = default;
+
+	template<typename U>
+	TrackingAllocator(const TrackingAllocator<U, Tag>&) {}
+
+	T *allocate(size_t p_count) {
+		Memory::Allocated(Tag, p_count * sizeof(T));
+
+		return static_cast<T*>(::operator new(p_count * sizeof(T)));
+	}
+
+	void deallocate(T *p_ptr, size_t p_count) {
+		Memory::Freed(Tag, p_count * sizeof(T));
+
+		::operator delete(p_ptr);
+	}
+
+	template<typename U>
+	bool operator ==(const TrackingAllocator<U, Tag>&) const {
+		return true;
+	}
+
+	template<typename U>
+	bool operator !=(const TrackingAllocator<U, Tag>&) const {
+		return false;
+	}
+};
+
+template<typename T, Memory::Tag Tag>
+using TrackedVector = std::vector<T, TrackingAllocator<T, Tag>>;
+
+template<typename T, Memory::Tag Tag>
+using TrackedList = std::list<T, TrackingAllocator<T, Tag>>;
+
+template<typename T, Memory::Tag Tag>
+using TrackedDeque = std::deque<T, TrackingAllocator<T, Tag>>;
+
+template<Memory::Tag Tag>
+using TrackedString = std::basic_string<char, std::char_traits<char>, TrackingAllocator<char, Tag>>;
+
+}
+
+#endif
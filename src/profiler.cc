@@ -0,0 +1,125 @@
+#include "profiler.hh"
+
+#ifdef CITY_BUILDER_PROFILE
+#	include <vector>  // std::vector
+#	include <memory>  // std::unique_ptr, std::make_unique
+#	include <mutex>   // std::mutex, std::lock_guard
+#	include <chrono>  // std::chrono::steady_clock, std::chrono::duration_cast
+#	include <sstream> // std::stringstream
+
+#	include "file.hh"
+#endif
+
+namespace CityBuilder {
+
+#ifdef CITY_BUILDER_PROFILE
+namespace Profiler {
+	struct Event {
+		enum Type : uint8_t {
+			Zone = 0,
+			Frame
+		};
+
+		const char *name;
+		uint64_t    start, end;
+		Type        type;
+	};
+
+	// Only the owning thread writes into a ring, so recording takes no lock
+	struct Ring {
+		Ring(size_t p_tid): tid(p_tid), head(0), count(0), events(PROFILER_RING_SIZE) {}
+
+		void Push(const Event &p_event) {
+			events[head] = p_event;
+
+			head = (head + 1) % events.size();
+			if (count < events.size())
+				++ count;
+		}
+
+		size_t tid, head, count;
+
+		std::vector<Event> events;
+	};
+
+	static const auto g_start = std::chrono::steady_clock::now();
+
+	static std::mutex                         g_ringsMutex;
+	static std::vector<std::unique_ptr<Ring>> g_rings;
+
+	static thread_local Ring *t_ring = nullptr;
+
+	static Ring &ThreadRing() {
+		if (t_ring == nullptr) {
+			std::lock_guard<std::mutex> lock(g_ringsMutex);
+
+			g_rings.push_back(std::make_unique<Ring>(g_rings.size()));
+			t_ring = g_rings.back().get();
+		}
+
+		return *t_ring;
+	}
+
+	static void WriteEscaped(std::stringstream &p_ss, const char *p_str) {
+		for (; *p_str != '\0'; ++ p_str) {
+			if (*p_str == '"' or *p_str == '\\')
+				p_ss << '\\';
+
+			p_ss << *p_str;
+		}
+	}
+
+	uint64_t Now() {
+		auto elapsed = std::chrono::steady_clock::now() - g_start;
+
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+	}
+
+	void Record(const char *p_name, uint64_t p_start, uint64_t p_end) {
+		ThreadRing().Push(Event{p_name, p_start, p_end, Event::Zone});
+	}
+
+	void Frame() {
+		uint64_t now = Now();
+
+		ThreadRing().Push(Event{"Frame", now, now, Event::Frame});
+	}
+
+	Error Export(const std::string &p_path) {
+		std::stringstream ss;
+		ss.precision(3);
+		ss << std::fixed << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+		bool first = true;
+
+		std::lock_guard<std::mutex> lock(g_ringsMutex);
+		for (const auto &ring : g_rings) {
+			// Oldest first, the ring may have wrapped around
+			size_t oldest = (ring->head + ring->events.size() - ring->count) % ring->events.size();
+
+			for (size_t i = 0; i < ring->count; ++ i) {
+				const Event &event = ring->events[(oldest + i) % ring->events.size()];
+
+				ss << (first? "" : ",") << "{\"name\":\"";
+				WriteEscaped(ss, event.name);
+
+				// Chrome trace timestamps are in microseconds
+				ss << "\",\"pid\":0,\"tid\":" << ring->tid << ",\"ts\":" << event.start / 1000.0;
+
+				if (event.type == Event::Frame)
+					ss << ",\"ph\":\"i\",\"s\":\"g\"}";
+				else
+					ss << ",\"ph\":\"X\",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+
+				first = false;
+			}
+		}
+
+		ss << "]}\n";
+
+		return WriteFile(p_path, ss.str());
+	}
+}
+#endif
+
+}
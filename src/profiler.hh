@@ -0,0 +1,57 @@
+#ifndef PROFILER_HH__HEADER_GUARD__
+#define PROFILER_HH__HEADER_GUARD__
+
+#include "utils.hh"
+
+// Zones recorded per thread before the oldest ones get overwritten
+#define PROFILER_RING_SIZE (64 * 1024)
+
+#ifdef CITY_BUILDER_PROFILE
+#	include <string> // std::string
+
+#	define __PROFILE_CONCAT(P_A, P_B) P_A##P_B
+#	define _PROFILE_CONCAT(P_A, P_B)  __PROFILE_CONCAT(P_A, P_B)
+
+// Times the rest of the enclosing scope, P_NAME has to be a string literal (only the pointer is kept)
+#	define PROFILE_ZONE(P_NAME) \
+		CityBuilder::Profiler::Zone _PROFILE_CONCAT(__profileZone, __LINE__)(P_NAME)
+#	define PROFILE_FRAME() CityBuilder::Profiler::Frame()
+#else
+#	define PROFILE_ZONE(P_NAME)
+#	define PROFILE_FRAME()
+#endif
+
+namespace CityBuilder {
+
+#ifdef CITY_BUILDER_PROFILE
+namespace Profiler {
+	// Nanoseconds since the program started
+	uint64_t Now();
+
+	void Record(const char *p_name, uint64_t p_start, uint64_t p_end);
+	void Frame();
+
+	// Writes everything still in the ring buffers as Chrome trace JSON (chrome://tracing or
+	// https://ui.perfetto.dev). Threads should not be recording while this runs
+	Error Export(const std::string &p_path);
+
+	class Zone {
+	public:
+		Zone(const char *p_name): m_name(p_name), m_start(Now()) {}
+		~Zone() {
+			Record(m_name, m_start, Now());
+		}
+
+		Zone(Zone &&p_zone)      = delete;
+		Zone(const Zone &p_zone) = delete;
+
+	private:
+		const char *m_name;
+		uint64_t    m_start;
+	};
+}
+#endif
+
+}
+
+#endif
@@ -0,0 +1,95 @@
+#include "render_context.hh"
+
+namespace CityBuilder {
+
+RenderContext::Stats::Stats() {
+	Reset();
+}
+
+void RenderContext::Stats::Reset() {
+	drawCalls    = 0;
+	textureBinds = 0;
+	colorChanges = 0;
+	clipChanges  = 0;
+}
+
+RenderContext::RenderContext():
+	raw(nullptr),
+
+	m_bound(nullptr),
+	m_frames(0)
+{}
+
+void RenderContext::Init(SDL_Renderer *p_renderer) {
+	raw = p_renderer;
+}
+
+void RenderContext::Clear(const Color4i &p_color) {
+	SDL_SetRenderDrawColor(raw, p_color.r, p_color.g, p_color.b, p_color.a);
+	SDL_RenderClear(raw);
+}
+
+void RenderContext::Copy(SDL_Texture *p_texture, const SDL_Rect &p_src, const SDL_Rect &p_dest) {
+	Bind(p_texture);
+	++ m_frame.drawCalls;
+
+	SDL_RenderCopy(raw, p_texture, &p_src, &p_dest);
+}
+
+void RenderContext::Geometry(SDL_Texture *p_texture, const SDL_Vertex *p_vertices,
+                             int p_verticesCount, const int *p_indices, int p_indicesCount) {
+	Bind(p_texture);
+	++ m_frame.drawCalls;
+
+	SDL_RenderGeometry(raw, p_texture, p_vertices, p_verticesCount, p_indices, p_indicesCount);
+}
+
+void RenderContext::FillRect(const SDL_Rect &p_rect, const Color4i &p_color) {
+	++ m_frame.colorChanges;
+	++ m_frame.drawCalls;
+
+	SDL_RenderColoredRect(raw, p_rect, p_color);
+}
+
+void RenderContext::SetTextureColor(SDL_Texture *p_texture, const Color4i &p_color) {
+	++ m_frame.colorChanges;
+
+	SDL_SetTextureColorMod(p_texture, p_color.r, p_color.g, p_color.b);
+	SDL_SetTextureAlphaMod(p_texture, p_color.a);
+}
+
+void RenderContext::SetClip(const SDL_Rect *p_clip) {
+	++ m_frame.clipChanges;
+
+	SDL_RenderSetClipRect(raw, p_clip);
+}
+
+void RenderContext::Present() {
+	SDL_RenderPresent(raw);
+
+	m_stats = m_frame;
+	m_frame.Reset();
+
+	// SDL may change the bound texture between frames
+	m_bound = nullptr;
+
+#ifdef CITY_BUILDER_LOG
+	if (++ m_frames % RENDER_STATS_LOG_FRAMES == 0)
+		Log("Render: ", m_stats.drawCalls, " draw calls, ", m_stats.textureBinds, " texture binds, ",
+		    m_stats.colorChanges, " color changes, ", m_stats.clipChanges, " clip changes");
+#endif
+}
+
+const RenderContext::Stats &RenderContext::GetStats() const {
+	return m_stats;
+}
+
+void RenderContext::Bind(SDL_Texture *p_texture) {
+	if (p_texture == m_bound)
+		return;
+
+	m_bound = p_texture;
+	++ m_frame.textureBinds;
+}
+
+}
@@ -0,0 +1,60 @@
+#ifndef RENDER_CONTEXT_HH__HEADER_GUARD__
+#define RENDER_CONTEXT_HH__HEADER_GUARD__
+
+#include <SDL2/SDL.h>
+
+#include "utils.hh"
+#include "units.hh"
+#include "sdl_ext.hh"
+
+// How often the per-frame counts are logged
+#define RENDER_STATS_LOG_FRAMES 600
+
+namespace CityBuilder {
+
+// Every draw goes through here instead of calling SDL directly, so the state changes and draw
+// calls of a frame can be counted. Counting is all it adds, nothing gets cached or skipped
+class RenderContext {
+public:
+	struct Stats {
+		Stats();
+
+		void Reset();
+
+		size_t drawCalls, textureBinds, colorChanges, clipChanges;
+	};
+
+	RenderContext();
+
+	void Init(SDL_Renderer *p_renderer);
+
+	void Clear(const Color4i &p_color);
+	void Copy(SDL_Texture *p_texture, const SDL_Rect &p_src, const SDL_Rect &p_dest);
+	void Geometry(SDL_Texture *p_texture, const SDL_Vertex *p_vertices, int p_verticesCount,
+	              const int *p_indices, int p_indicesCount);
+	void FillRect(const SDL_Rect &p_rect, const Color4i &p_color);
+
+	void SetTextureColor(SDL_Texture *p_texture, const Color4i &p_color);
+	// nullptr removes the clip
+	void SetClip(const SDL_Rect *p_clip);
+
+	// Ends the frame, its counts become the ones GetStats() returns
+	void Present();
+
+	// Of the last presented frame
+	const Stats &GetStats() const;
+
+	SDL_Renderer *raw;
+
+private:
+	void Bind(SDL_Texture *p_texture);
+
+	SDL_Texture *m_bound;
+	size_t       m_frames;
+
+	Stats m_frame, m_stats;
+};
+
+}
+
+#endif
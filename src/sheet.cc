@@ -16,12 +16,17 @@ void Sheet::Render(Tile::ID p_id, const Rectf &p_dest) {
 	if (m_sheet == nullptr)
 		Panic(__FUNC__, "() sheet is nullptr");
 
-	Vec2i size = m_sheet->Size();
+	m_sheet->Render(Source(p_id), p_dest);
+}
+
+Rectf Sheet::Source(Tile::ID p_id) const {
+	if (m_sheet == nullptr)
+		Panic(__FUNC__, "() sheet is nullptr");
 
-	Rectf src(Vec2f(p_id % (size.x / m_tileSize.x) * m_tileSize.x,
-	                p_id / (size.y / m_tileSize.y) * m_tileSize.y), m_tileSize);
+	Vec2i size = m_sheet->Size();
 
-	m_sheet->Render(src, p_dest);
+	return Rectf(Vec2f(p_id % (size.x / m_tileSize.x) * m_tileSize.x,
+	                   p_id / (size.y / m_tileSize.y) * m_tileSize.y), m_tileSize);
 }
 
 }
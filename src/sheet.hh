@@ -16,6 +16,9 @@ public:
 	void SetSheet(Texture &p_sheet);
 	void Render(Tile::ID p_id, const Rectf &p_dest);
 
+	// Relative to the sheet texture region
+	Rectf Source(Tile::ID p_id) const;
+
 private:
 	Texture *m_sheet;
 	Vec2i    m_tileSize;
@@ -0,0 +1,87 @@
+#ifndef SPSC_QUEUE_HH__HEADER_GUARD__
+#define SPSC_QUEUE_HH__HEADER_GUARD__
+
+#include <atomic> // std::atomic, std::memory_order_relaxed, std::memory_order_acquire,
+                  // std::memory_order_release
+#include <array>  // std::array
+
+#include "utils.hh"
+
+// Keeps the indices written by different threads on different cache lines
+#define CACHE_LINE_SIZE 64
+
+namespace CityBuilder {
+
+// Bounded queue between exactly one producer thread and one consumer thread, neither side ever
+// locks or blocks. Each side keeps a copy of the other side's index and only reloads it when the
+// queue looks full or empty, so they rarely touch each other's cache line
+template<typename T, size_t Capacity>
+class SPSCQueue {
+	static_assert(Capacity > 0 and (Capacity & (Capacity - 1)) == 0,
+	              "SPSCQueue capacity has to be a power of 2");
+
+public:
+	SPSCQueue():
+		m_head(0),
+		m_cachedTail(0),
+		m_tail(0),
+		m_cachedHead(0)
+	{}
+
+	SPSCQueue(SPSCQueue &&p_queue)      = delete;
+	SPSCQueue(const SPSCQueue &p_queue) = delete;
+
+	// Producer only, returns false when the queue is full
+	bool Push(const T &p_item) {
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		if (tail - m_cachedHead == Capacity) {
+			m_cachedHead = m_head.load(std::memory_order_acquire);
+			if (tail - m_cachedHead == Capacity)
+				return false;
+		}
+
+		m_items[tail & (Capacity - 1)] = p_item;
+		m_tail.store(tail + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	// Producer only, a Push() right after a false is guaranteed to succeed
+	bool Full() {
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		if (tail - m_cachedHead == Capacity)
+			m_cachedHead = m_head.load(std::memory_order_acquire);
+
+		return tail - m_cachedHead == Capacity;
+	}
+
+	// Consumer only, returns false when the queue is empty
+	bool Pop(T &p_item) {
+		size_t head = m_head.load(std::memory_order_relaxed);
+		if (head == m_cachedTail) {
+			m_cachedTail = m_tail.load(std::memory_order_acquire);
+			if (head == m_cachedTail)
+				return false;
+		}
+
+		p_item = m_items[head & (Capacity - 1)];
+		m_head.store(head + 1, std::memory_order_release);
+
+		return true;
+	}
+
+private:
+	// Written by the consumer
+	alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head;
+	size_t                                       m_cachedTail;
+
+	// Written by the producer
+	alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail;
+	size_t                                       m_cachedHead;
+
+	alignas(CACHE_LINE_SIZE) std::array<T, Capacity> m_items;
+};
+
+}
+
+#endif
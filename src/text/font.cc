@@ -5,8 +5,8 @@
 namespace CityBuilder {
 
 namespace Text {
-	ErrorOr<Font> Font::FromFile(const std::string &p_sheetPath, const std::string &p_infoPath) {
-		INI ini;
+	ErrorOr<Font> Font::FromFile(const std::string &p_infoPath) {
+		INIView ini;
 		auto err = ini.ParseFile(p_infoPath);
 		if (not err.Ok())
 			return ErrorOr<Font>::Make("'", p_infoPath, "': ", err.Desc());
@@ -44,51 +44,17 @@ namespace Text {
 		Log("Loaded font info file '", p_infoPath, "'");
 #endif
 
-		SDL_Surface *surface = SDL_LoadBMPWithTransparency(p_sheetPath.c_str(),
-		                                                   r.unwrap, g.unwrap, b.unwrap);
-		if (surface == nullptr)
-			return ErrorOr<Font>::Make("Failed to load texture '", p_sheetPath, "': ",
-			                           SDL_GetError());
-
-#ifdef CITY_BUILDER_LOG
-		Log("Loaded font sheet file '", p_sheetPath, "'");
-#endif
-
-		return ErrorOr<Font>::Fine(std::move(Font(surface, w.unwrap, h.unwrap, surface->w / w.unwrap)));
+		return ErrorOr<Font>::Fine(Font(w.unwrap, h.unwrap, Color4i(r.unwrap, g.unwrap, b.unwrap)));
 	}
 
-	Font::Font(SDL_Surface *p_sheet, size_t p_chW, size_t p_chH, size_t p_chsInARow):
-		sheet(p_sheet),
+	Font::Font(size_t p_chW, size_t p_chH, const Color4i &p_alpha):
+		sheet(nullptr),
 
 		m_chW(p_chW),
 		m_chH(p_chH),
-		m_chsInARow(p_chsInARow)
-	{
-		if (sheet == nullptr)
-			Panic("Attempted to construct Font from nullptr sheet");
-	}
-
-	Font::Font(Font &&p_font):
-		Font(p_font.sheet, p_font.m_chW, p_font.m_chH, p_font.m_chsInARow)
-	{
-		p_font.sheet = nullptr;
-	}
-
-	Font::~Font() {
-		if (sheet != nullptr) {
-			SDL_FreeSurface(sheet);
-
-			sheet = nullptr;
-		}
-	}
-
-	void Font::Free() {
-		if (sheet == nullptr)
-			Panic("Attempt to free a nullptr font sheet");
-
-		SDL_FreeSurface(sheet);
-		sheet = nullptr;
-	}
+		m_chsInARow(1),
+		m_alpha(p_alpha)
+	{}
 
 	size_t Font::CharW() const {
 		return m_chW;
@@ -98,8 +64,19 @@ namespace Text {
 		return m_chH;
 	}
 
+	const Color4i &Font::Alpha() const {
+		return m_alpha;
+	}
+
+	void Font::SetSheet(Texture &p_sheet) {
+		sheet       = &p_sheet;
+		m_chsInARow = std::max<size_t>(p_sheet.Size().x / m_chW, 1);
+	}
+
 	Vec2i Font::GetCharSheetPos(char p_ch) const {
-		return Vec2i(p_ch % m_chsInARow * m_chW, p_ch / m_chsInARow * m_chH);
+		size_t idx = static_cast<uint8_t>(p_ch);
+
+		return Vec2i(idx % m_chsInARow * m_chW, idx / m_chsInARow * m_chH);
 	}
 }
 
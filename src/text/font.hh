@@ -1,42 +1,43 @@
 #ifndef FONT_HH__HEADER_GUARD__
 #define FONT_HH__HEADER_GUARD__
 
-#include <string>  // std::string
-#include <utility> // std::pair, std::make_pair
+#include <string>    // std::string
+#include <utility>   // std::pair, std::make_pair
+#include <algorithm> // std::max
 
 #include <SDL2/SDL.h>
 
 #include "../units.hh"
 #include "../utils.hh"
 #include "../ini.hh"
-#include "../sdl_ext.hh"
+#include "../texture.hh"
 
 namespace CityBuilder {
 
 namespace Text {
+	// Glyph metrics of a font. The sheet itself is a texture in the atlas, bound by SetSheet()
 	class Font {
 	public:
 		[[nodiscard]]
-		static ErrorOr<Font> FromFile(const std::string &p_sheetPath, const std::string &p_infoPath);
+		static ErrorOr<Font> FromFile(const std::string &p_infoPath);
 
-		Font(SDL_Surface *p_sheet, size_t p_chW, size_t p_chH, size_t p_chsInARow);
-		Font(Font &&p_font);
-		Font(const Font &p_font) = delete;
-		Font()                   = delete;
-
-		~Font();
-
-		void Free();
+		Font(size_t p_chW, size_t p_chH, const Color4i &p_alpha);
 
 		size_t CharW() const;
 		size_t CharH() const;
 
+		// The color keyed out of the sheet
+		const Color4i &Alpha() const;
+
+		void SetSheet(Texture &p_sheet);
+
 		Vec2i GetCharSheetPos(char p_ch) const;
 
-		SDL_Surface *sheet;
+		Texture *sheet;
 
 	private:
-		size_t m_chW, m_chH, m_chsInARow;
+		size_t  m_chW, m_chH, m_chsInARow;
+		Color4i m_alpha;
 	};
 }
 
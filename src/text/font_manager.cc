@@ -3,19 +3,28 @@
 namespace CityBuilder {
 
 namespace Text {
-	Error FontManager::FromFile(const std::string &p_key,
-	                            const std::string &p_sheetPath, const std::string &p_infoPath) {
-		auto font = Font::FromFile(p_sheetPath, p_infoPath);
+	Error FontManager::FromFile(const std::string &p_key, const std::string &p_sheetPath,
+	                            const std::string &p_infoPath, TextureManager &p_textures) {
+		auto font = Font::FromFile(p_infoPath);
 		if (not font.Ok())
 			return Error::Make(font.Desc());
 
+		auto err = p_textures.FromFile(FONT_SHEET_KEY(p_key), p_sheetPath, font.Value().Alpha());
+		if (not err.Ok())
+			return err;
+
 		_Add(p_key, std::move(font.Value()));
 
 		return Error::Fine();
 	}
 
+	void FontManager::BindSheets(TextureManager &p_textures) {
+		for (auto &[key, handle] : m_index)
+			Get(handle).SetSheet(p_textures.Get(FONT_SHEET_KEY(key)));
+	}
+
 	void FontManager::Clear() {
-		m_library.clear();
+		_Clear();
 	}
 }
 
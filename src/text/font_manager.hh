@@ -9,14 +9,21 @@
 
 #include "../utils.hh"
 #include "../manager.hh"
+#include "../texture_manager.hh"
+
+#define FONT_SHEET_KEY(P_KEY) ("fonts/" + (P_KEY))
 
 namespace CityBuilder {
 
 namespace Text {
 	class FontManager : public Manager<Font, std::string> {
 	public:
-		Error FromFile(const std::string &p_key,
-		               const std::string &p_sheetPath, const std::string &p_infoPath);
+		// The sheet is queued into p_textures under FONT_SHEET_KEY(p_key), BindSheets() has to be
+		// called once the atlas is built
+		Error FromFile(const std::string &p_key, const std::string &p_sheetPath,
+		               const std::string &p_infoPath, TextureManager &p_textures);
+
+		void BindSheets(TextureManager &p_textures);
 
 		void Clear();
 	};
@@ -5,43 +5,116 @@
 namespace CityBuilder {
 
 namespace Text {
-	Renderer::Renderer() {}
+	Renderer::Stats::Stats():
+		hits(0),
+		misses(0),
+		evictions(0),
 
-	void Renderer::ClearCache() {
-		m_cache.clear();
+		entries(0),
+		bytes(0)
+	{}
+
+	bool Renderer::Key::operator ==(const Key &p_key) const {
+		return font == p_key.font and lineChLimit == p_key.lineChLimit and text == p_key.text;
 	}
 
-	ErrorOr<Texture*> Renderer::Render(const std::string &p_text, Font &p_font,
-	                                   const Color4i &p_color, size_t p_lineChLimit) {
-		if (m_cache.count(p_text) != 0) {
-			m_cache.at(p_text).SetColor(p_color);
+	size_t Renderer::KeyHash::operator ()(const Key &p_key) const {
+		size_t hash = std::hash<std::string_view>()(p_key.text);
+		hash ^= std::hash<const Font*>()(p_key.font) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+		hash ^= std::hash<size_t>()(p_key.lineChLimit) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
 
-			return ErrorOr<Texture*>::Fine(&m_cache.at(p_text));
-		}
+		return hash;
+	}
+
+	Renderer::Entry::Entry(const std::string &p_text, const Font *p_font, size_t p_lineChLimit):
+		text(p_text.data(), p_text.size()),
+		font(p_font),
+		lineChLimit(p_lineChLimit),
+
+		bytes(0)
+	{}
+
+	Renderer::Renderer() {}
+
+	void Renderer::ClearCache() {
+		m_index.clear();
+		m_lru.clear();
+
+		m_stats.entries = 0;
+		m_stats.bytes   = 0;
+	}
 
+	Vec2f Renderer::Measure(const std::string &p_text, const Font &p_font,
+	                        size_t p_lineChLimit) const {
 		size_t lines   = 1;
 		size_t lineLen = p_text.length();
 		if (p_lineChLimit != TEXT_LINE_CH_LIMIT_NONE) {
-			lines   = std::ceil(static_cast<double>(p_text.length() / p_lineChLimit));
+			lines   = std::ceil(static_cast<double>(p_text.length()) / p_lineChLimit);
 			lineLen = p_lineChLimit;
 		}
 
-		SDL_Surface *surface = SDL_CreateRGBSurface(0, lineLen * p_font.CharW(),
-		                                            lines * (p_font.CharH() + TEXT_LINES_PADDING),
-		                                            32, 0, 0, 0, 0);
-		if (surface == nullptr)
-			return ErrorOr<Texture*>::Make("Failed to create text surface: ", SDL_GetError());
+		return Vec2f(lineLen * p_font.CharW(), lines * (p_font.CharH() + TEXT_LINES_PADDING));
+	}
+
+	void Renderer::Draw(DrawList &p_drawList, const std::string &p_text, Font &p_font,
+	                    const Vec2f &p_pos, float p_scale, const Color4i &p_color,
+	                    size_t p_lineChLimit) {
+		PROFILE_ZONE("Text::Renderer::Draw");
+
+		if (p_font.sheet == nullptr)
+			Panic("Text::Renderer::", __FUNC__, "() font has no sheet bound (it is nullptr)");
+
+		const Entry &entry = Layout(p_text, p_font, p_lineChLimit);
+		if (entry.quads.empty())
+			return;
+
+		Rectf bounds(p_pos, Measure(p_text, p_font, p_lineChLimit) * p_scale);
 
-		uint32_t colorKey = SDL_MapRGB(surface->format, 0, 0, 0);
-		SDL_SetColorKey(surface, true, colorKey);
+		SDL_Vertex *vertices = p_drawList.AddQuads(p_font.sheet->raw, entry.quads.size() / 4, bounds);
+		SDL_Color   color    = p_color;
 
-		SDL_Rect src;
-		src.w = p_font.CharW();
-		src.h = p_font.CharH();
+		for (size_t i = 0; i < entry.quads.size(); ++ i) {
+			vertices[i]            = entry.quads[i];
+			vertices[i].position.x = p_pos.x + entry.quads[i].position.x * p_scale;
+			vertices[i].position.y = p_pos.y + entry.quads[i].position.y * p_scale;
+			vertices[i].color      = color;
+		}
+	}
+
+	const Renderer::Stats &Renderer::GetStats() const {
+		return m_stats;
+	}
+
+	void Renderer::ResetStats() {
+		m_stats.hits      = 0;
+		m_stats.misses    = 0;
+		m_stats.evictions = 0;
+	}
 
-		SDL_Rect dest = src;
-		dest.x = 0;
-		dest.y = 0;
+	const Renderer::Entry &Renderer::Layout(const std::string &p_text, const Font &p_font,
+	                                        size_t p_lineChLimit) {
+		PROFILE_ZONE("Text::Renderer::Layout");
+
+		auto it = m_index.find(Key{p_text, &p_font, p_lineChLimit});
+		if (it != m_index.end()) {
+			++ m_stats.hits;
+
+			m_lru.splice(m_lru.begin(), m_lru, it->second);
+
+			return *it->second;
+		}
+
+		++ m_stats.misses;
+
+		Entry entry(p_text, &p_font, p_lineChLimit);
+
+		size_t lineLen = p_lineChLimit == TEXT_LINE_CH_LIMIT_NONE? p_text.length() : p_lineChLimit;
+
+		const Texture &sheet  = *p_font.sheet;
+		Vec2f          raw    = sheet.RawSize();
+		Vec2f          chSize(p_font.CharW(), p_font.CharH());
+
+		entry.quads.reserve(p_text.length() * 4);
 
 		size_t x = 0, y = 0;
 		for (size_t i = 0; i < p_text.length(); ++ i) {
@@ -50,29 +123,68 @@ namespace Text {
 				x = 0;
 			}
 
-			dest.x = x * dest.w;
-			dest.y = y * (dest.h + TEXT_LINES_PADDING);
+			// Nothing to draw for spaces, but they still take up room
+			if (p_text[i] == ' ') {
+				++ x;
+
+				continue;
+			}
+
+			Vec2f pos(x * chSize.x, y * (chSize.y + TEXT_LINES_PADDING));
+			Vec2f src = static_cast<Vec2f>(p_font.GetCharSheetPos(p_text[i]) + sheet.region.Pos());
 
-			Vec2i pos = p_font.GetCharSheetPos(p_text[i]);
-			src.x = pos.x;
-			src.y = pos.y;
+			Vec2f uv0 = src / raw, uv1 = (src + chSize) / raw;
 
-			SDL_BlitSurface(p_font.sheet, &src, surface, &dest);
+			SDL_Vertex vertex;
+			vertex.color = Color4i(255);
+
+			vertex.position  = {pos.x,            pos.y};
+			vertex.tex_coord = {uv0.x,            uv0.y};
+			entry.quads.push_back(vertex);
+
+			vertex.position  = {pos.x + chSize.x, pos.y};
+			vertex.tex_coord = {uv1.x,            uv0.y};
+			entry.quads.push_back(vertex);
+
+			vertex.position  = {pos.x + chSize.x, pos.y + chSize.y};
+			vertex.tex_coord = {uv1.x,            uv1.y};
+			entry.quads.push_back(vertex);
+
+			vertex.position  = {pos.x,            pos.y + chSize.y};
+			vertex.tex_coord = {uv0.x,            uv1.y};
+			entry.quads.push_back(vertex);
 
 			++ x;
 		}
 
-		SDL_Texture *texture = SDL_CreateTextureFromSurface(Game::Get().renderer, surface);
-		if (texture == nullptr)
-			return ErrorOr<Texture*>::Make("Failed to create text texture: ", SDL_GetError());
+		entry.bytes = sizeof(Entry) + entry.text.capacity() +
+		              entry.quads.capacity() * sizeof(SDL_Vertex);
+
+		Evict(entry.bytes);
 
-		if (m_cache.size() + 1 >= MAX_TEXT_CACHE_SIZE)
-			ClearCache();
+		m_lru.push_front(std::move(entry));
+		m_index.emplace(Key{m_lru.front().text, &p_font, p_lineChLimit}, m_lru.begin());
 
-		m_cache.emplace(p_text, std::move(Texture(texture)));
-		m_cache.at(p_text).SetColor(p_color);
+		++ m_stats.entries;
+		m_stats.bytes += m_lru.front().bytes;
 
-		return ErrorOr<Texture*>::Fine(&m_cache.at(p_text));
+		return m_lru.front();
+	}
+
+	void Renderer::Evict(size_t p_bytes) {
+		// Least recently used entries go first, until the new one fits into the budget
+		while (not m_lru.empty() and m_stats.bytes + p_bytes > TEXT_CACHE_BUDGET) {
+			Entry &entry = m_lru.back();
+
+			// The key views the entry text, so it has to go before the entry does
+			m_index.erase(Key{entry.text, entry.font, entry.lineChLimit});
+
+			m_stats.bytes -= entry.bytes;
+			-- m_stats.entries;
+			++ m_stats.evictions;
+
+			m_lru.pop_back();
+		}
 	}
 }
 
@@ -2,7 +2,10 @@
 #define TEXT_RENDERER_HH__HEADER_GUARD__
 
 #include <unordered_map> // std::unordered_map
+#include <list>          // std::list
+#include <vector>        // std::vector
 #include <string>        // std::string
+#include <string_view>   // std::string_view, std::hash
 #include <cmath>         // std::ceil
 
 #include <SDL2/SDL.h>
@@ -12,8 +15,11 @@
 #include "../utils.hh"
 #include "../units.hh"
 #include "../texture.hh"
+#include "../draw_list.hh"
+#include "../memory.hh"
 
-#define MAX_TEXT_CACHE_SIZE 256
+// Approximate memory the cached glyph layouts may take up, in bytes
+#define TEXT_CACHE_BUDGET (1024 * 1024)
 
 #define TEXT_LINE_CH_LIMIT_NONE 0
 #define TEXT_LINES_PADDING      1
@@ -21,20 +27,74 @@
 namespace CityBuilder {
 
 namespace Text {
+	// Records text into a DrawList as textured quads straight from the font sheet in the atlas,
+	// so no text ever allocates a texture and the color is per vertex. The glyph layout of each
+	// string is cached, so repeated strings skip the layout work
 	class Renderer {
 	public:
+		struct Stats {
+			Stats();
+
+			size_t hits, misses, evictions;
+			size_t entries, bytes;
+		};
+
 		Renderer();
 
 		Renderer(const Renderer &p_copy) = delete;
 		Renderer(Renderer &&p_move)      = delete;
 
 		void ClearCache();
-		ErrorOr<Texture*> Render(const std::string &p_text, Font &p_font,
-	                             const Color4i &p_color = Color4i(255),
-	                             size_t p_lineChLimit = TEXT_LINE_CH_LIMIT_NONE);
+
+		Vec2f Measure(const std::string &p_text, const Font &p_font,
+		              size_t p_lineChLimit = TEXT_LINE_CH_LIMIT_NONE) const;
+
+		void Draw(DrawList &p_drawList, const std::string &p_text, Font &p_font,
+		          const Vec2f &p_pos, float p_scale = 1, const Color4i &p_color = Color4i(255),
+		          size_t p_lineChLimit = TEXT_LINE_CH_LIMIT_NONE);
+
+		const Stats &GetStats() const;
+		void         ResetStats();
 
 	private:
-		std::unordered_map<std::string, Texture> m_cache;
+		// The text is a view into the string owned by the cache entry, so lookups dont allocate
+		struct Key {
+			bool operator ==(const Key &p_key) const;
+
+			std::string_view text;
+			const Font      *font;
+			size_t           lineChLimit;
+		};
+
+		struct KeyHash {
+			size_t operator ()(const Key &p_key) const;
+		};
+
+		// Glyph quads at scale 1 relative to the text position, with atlas texture coordinates
+		struct Entry {
+			Entry(const std::string &p_text, const Font *p_font, size_t p_lineChLimit);
+
+			TrackedString<Memory::TextCache> text;
+			const Font                      *font;
+			size_t                           lineChLimit;
+
+			TrackedVector<SDL_Vertex, Memory::TextCache> quads;
+			size_t                                       bytes;
+		};
+
+		using LRU   = TrackedList<Entry, Memory::TextCache>;
+		using Index = std::unordered_map<Key, LRU::iterator, KeyHash, std::equal_to<Key>,
+		                                 TrackingAllocator<std::pair<const Key, LRU::iterator>,
+		                                                   Memory::TextCache>>;
+
+		const Entry &Layout(const std::string &p_text, const Font &p_font, size_t p_lineChLimit);
+
+		void Evict(size_t p_bytes);
+
+		LRU   m_lru; // Most recently used first
+		Index m_index;
+
+		Stats m_stats;
 	};
 }
 
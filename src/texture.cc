@@ -32,21 +32,55 @@ ErrorOr<Texture> Texture::FromFile(const std::string &p_path, const Color4i &p_a
 }
 
 Texture::Texture(SDL_Texture *p_raw):
-	raw(p_raw)
+	raw(p_raw),
+	m_owner(true)
 {
 	if (raw == nullptr)
 		Panic("Attempted to construct Texture from nullptr");
+
+	int w, h;
+	SDL_QueryTexture(raw, nullptr, nullptr, &w, &h);
+
+	region    = Recti(0, 0, w, h);
+	m_rawSize = Vec2i(w, h);
+
+	uint32_t format;
+	SDL_QueryTexture(raw, &format, nullptr, nullptr, nullptr);
+
+	m_bytes = static_cast<size_t>(w) * h * SDL_BYTESPERPIXEL(format);
+	Memory::Allocated(Memory::Textures, m_bytes);
+}
+
+Texture::Texture(SDL_Texture *p_page, const Recti &p_region):
+	raw(p_page),
+	region(p_region),
+	m_owner(false),
+	m_bytes(0)
+{
+	if (raw == nullptr)
+		Panic("Attempted to construct Texture view from nullptr");
+
+	int w, h;
+	SDL_QueryTexture(raw, nullptr, nullptr, &w, &h);
+
+	m_rawSize = Vec2i(w, h);
 }
 
 Texture::Texture(Texture &&p_texture):
-	Texture(p_texture.raw)
+	raw(p_texture.raw),
+	region(p_texture.region),
+	m_owner(p_texture.m_owner),
+	m_rawSize(p_texture.m_rawSize),
+	m_bytes(p_texture.m_bytes)
 {
-	p_texture.raw = nullptr;
+	p_texture.raw     = nullptr;
+	p_texture.m_bytes = 0;
 }
 
 Texture::~Texture() {
-	if (raw != nullptr) {
+	if (raw != nullptr and m_owner) {
 		SDL_DestroyTexture(raw);
+		Memory::Freed(Memory::Textures, m_bytes);
 
 		raw = nullptr;
 	}
@@ -56,38 +90,43 @@ void Texture::Free() {
 	if (raw == nullptr)
 		Panic("Attempt to free a nullptr texture");
 
-	SDL_DestroyTexture(raw);
-	raw = nullptr;
+	if (m_owner) {
+		SDL_DestroyTexture(raw);
+		Memory::Freed(Memory::Textures, m_bytes);
+	}
+
+	raw     = nullptr;
+	m_bytes = 0;
 }
 
 void Texture::Render(const Recti &p_dest) {
-	SDL_Rect dest = p_dest;
+	SDL_Rect src = region, dest = p_dest;
 
-	SDL_RenderCopy(Game::Get().renderer, raw, nullptr, &dest);
+	Game::Get().renderContext.Copy(raw, src, dest);
 }
 
 void Texture::Render(const Vec2i &p_pos) {
-	SDL_Rect dest(Recti(p_pos, Size()));
+	SDL_Rect src = region, dest(Recti(p_pos, Size()));
 
-	SDL_RenderCopy(Game::Get().renderer, raw, nullptr, &dest);
+	Game::Get().renderContext.Copy(raw, src, dest);
 }
 
 void Texture::Render(const Recti &p_src, const Recti &p_dest) {
-	SDL_Rect src = p_src, dest = p_dest;
+	SDL_Rect src = Recti(p_src.Pos() + region.Pos(), p_src.Size()), dest = p_dest;
 
-	SDL_RenderCopy(Game::Get().renderer, raw, &src, &dest);
+	Game::Get().renderContext.Copy(raw, src, dest);
 }
 
 Vec2i Texture::Size() const {
-	int w, h;
-	SDL_QueryTexture(raw, nullptr, nullptr, &w, &h);
+	return region.Size();
+}
 
-	return Vec2i(w, h);
+Vec2i Texture::RawSize() const {
+	return m_rawSize;
 }
 
 void Texture::SetColor(const Color4i &p_color) {
-	SDL_SetTextureColorMod(raw, p_color.r, p_color.g, p_color.b);
-	SDL_SetTextureAlphaMod(raw, p_color.a);
+	Game::Get().renderContext.SetTextureColor(raw, p_color);
 }
 
 }
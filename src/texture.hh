@@ -6,6 +6,7 @@
 #include "utils.hh"
 #include "units.hh"
 #include "sdl_ext.hh"
+#include "memory.hh"
 
 namespace CityBuilder {
 
@@ -18,6 +19,8 @@ struct Texture {
 	                                 const Color4i &p_a = Color4i(255, 0, 255));
 
 	Texture(SDL_Texture *p_raw);
+	// A non-owning view into a region of p_page (for atlas pages)
+	Texture(SDL_Texture *p_page, const Recti &p_region);
 	Texture(Texture &&p_texture);
 	Texture(const Texture &p_texture) = delete;
 	Texture()                         = delete;
@@ -31,10 +34,20 @@ struct Texture {
 	void Render(const Recti &p_src, const Recti &p_dest);
 
 	Vec2i Size() const;
+	// Size of the whole underlying texture (the atlas page for views)
+	Vec2i RawSize() const;
 
+	// Keep in mind that atlas views share the page, so the color applies to the whole page
 	void SetColor(const Color4i &p_color);
 
 	SDL_Texture *raw;
+	Recti        region;
+
+private:
+	bool  m_owner;
+	Vec2i m_rawSize;
+	// Estimated from the size and pixel format, counted only by the owner
+	size_t m_bytes;
 };
 
 }
@@ -6,17 +6,144 @@ namespace CityBuilder {
 
 Error TextureManager::FromFile(const std::string &p_key, const std::string &p_path,
                                const Color4i &p_a) {
-	auto texture = Texture::FromFile(p_path, p_a);
-	if (not texture.Ok())
-		return Error::Make(texture.Desc());
+	SDL_Surface *surface = SDL_LoadBMPWithTransparency(p_path.c_str(), p_a.r, p_a.g, p_a.b);
+	if (surface == nullptr)
+		return Error::Make("Failed to load texture '", p_path, "': ", SDL_GetError());
 
-	_Add(p_key, std::move(texture.Value()));
+#ifdef CITY_BUILDER_LOG
+	Log("Loaded texture '", p_path, "'");
+#endif
+
+	m_pending.push_back(Pending(p_key, surface));
+
+	return Error::Fine();
+}
+
+Error TextureManager::BuildAtlas() {
+	// Tallest first packs best with a skyline
+	std::sort(m_pending.begin(), m_pending.end(), [](const Pending &p_a, const Pending &p_b) {
+		if (p_a.second->h != p_b.second->h)
+			return p_a.second->h > p_b.second->h;
+		else
+			return p_a.second->w > p_b.second->w;
+	});
+
+	struct Placed {
+		Placed(): standalone(false), page(0) {}
+
+		bool   standalone;
+		size_t page;
+		Recti  rect;
+	};
+
+	std::vector<SkylinePacker> packers;
+	std::vector<SDL_Surface*>  pages;
+	std::vector<Placed>        placed(m_pending.size());
+
+	auto freePages = [&pages]() {
+		for (auto page : pages)
+			SDL_FreeSurface(page);
+	};
+
+	for (size_t i = 0; i < m_pending.size(); ++ i) {
+		SDL_Surface *surface = m_pending[i].second;
+		Vec2i        size(surface->w + ATLAS_PADDING, surface->h + ATLAS_PADDING);
+
+		// Too big to share a page, so it gets a texture of its own
+		if (size.x > ATLAS_PAGE_W or size.y > ATLAS_PAGE_H) {
+			auto texture = Texture::FromSurface(surface);
+			if (not texture.Ok()) {
+				freePages();
+				FreePending();
+
+				return Error::Make(texture.Desc());
+			}
+
+			_Add(m_pending[i].first, std::move(texture.Value()));
+			placed[i].standalone = true;
+
+			continue;
+		}
+
+		Maybe<Vec2i> pos;
+		size_t       page = 0;
+		for (; page < packers.size(); ++ page) {
+			pos = packers[page].Insert(size);
+			if (not pos.none)
+				break;
+		}
+
+		if (pos.none) {
+			SDL_Surface *pageSurface = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_PAGE_W, ATLAS_PAGE_H,
+			                                                          32, SDL_PIXELFORMAT_RGBA32);
+			if (pageSurface == nullptr) {
+				freePages();
+				FreePending();
+
+				return Error::Make("Failed to create atlas page: ", SDL_GetError());
+			}
+
+			SDL_FillRect(pageSurface, nullptr, SDL_MapRGBA(pageSurface->format, 0, 0, 0, 0));
+
+			pages.push_back(pageSurface);
+			packers.push_back(SkylinePacker(ATLAS_PAGE_SIZE));
+
+			pos = packers.back().Insert(size);
+		}
+
+		placed[i].page = page;
+		placed[i].rect = Recti(pos.unwrap, Vec2i(surface->w, surface->h));
+
+		SDL_Rect dest = placed[i].rect;
+		SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+		SDL_BlitSurface(surface, nullptr, pages[page], &dest);
+	}
+
+	size_t first = m_pages.size();
+	for (auto page : pages) {
+		auto texture = Texture::FromSurface(page);
+		if (not texture.Ok()) {
+			freePages();
+			FreePending();
+
+			return Error::Make("Failed to create atlas page texture: ", texture.Desc());
+		}
+
+		SDL_SetTextureBlendMode(texture.Value().raw, SDL_BLENDMODE_BLEND);
+		m_pages.push_back(std::move(texture.Value()));
+	}
+
+	for (size_t i = 0; i < m_pending.size(); ++ i) {
+		if (not placed[i].standalone)
+			_Add(m_pending[i].first, Texture(m_pages[first + placed[i].page].raw, placed[i].rect));
+	}
+
+#ifdef CITY_BUILDER_LOG
+	Log("Packed ", m_pending.size(), " textures into ", pages.size(), " atlas page(s)");
+#endif
+
+	freePages();
+	FreePending();
 
 	return Error::Fine();
 }
 
+size_t TextureManager::PagesCount() const {
+	return m_pages.size();
+}
+
 void TextureManager::Clear() {
-	m_library.clear();
+	_Clear();
+	m_pages.clear();
+
+	FreePending();
+}
+
+void TextureManager::FreePending() {
+	for (auto &pending : m_pending)
+		SDL_FreeSurface(pending.second);
+
+	m_pending.clear();
 }
 
 }
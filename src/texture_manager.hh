@@ -1,7 +1,10 @@
 #ifndef TEXTURE_MANAGER_HH__HEADER_GUARD__
 #define TEXTURE_MANAGER_HH__HEADER_GUARD__
 
-#include <string> // std::string
+#include <string>    // std::string
+#include <vector>    // std::vector
+#include <utility>   // std::pair
+#include <algorithm> // std::sort
 
 #include <SDL2/SDL.h>
 
@@ -9,15 +12,30 @@
 #include "manager.hh"
 #include "units.hh"
 #include "texture.hh"
+#include "atlas.hh"
 
 namespace CityBuilder {
 
+// Loaded images are only queued, BuildAtlas() packs them into shared pages and adds views into
+// those pages, so UI draws that follow each other dont have to switch textures
 class TextureManager : public Manager<Texture, std::string> {
 public:
 	Error FromFile(const std::string &p_key, const std::string &p_path,
 	               const Color4i &p_a = Color4i(255, 0, 255));
 
+	Error BuildAtlas();
+
+	size_t PagesCount() const;
+
 	void Clear();
+
+private:
+	using Pending = std::pair<std::string, SDL_Surface*>;
+
+	void FreePending();
+
+	std::vector<Pending> m_pending;
+	std::vector<Texture> m_pages;
 };
 
 }
@@ -0,0 +1,160 @@
+#include "timer.hh"
+
+namespace CityBuilder {
+
+TimerWheel::TimerWheel():
+	m_free(none),
+	m_count(0),
+	m_now(0)
+{
+	std::fill_n(m_heads, expiring + 1, none);
+}
+
+bool TimerWheel::Cancel(const ID &p_id) {
+	if (not Pending(p_id))
+		return false;
+
+	Unlink(p_id.idx);
+	Release(p_id.idx);
+
+	return true;
+}
+
+bool TimerWheel::Pending(const ID &p_id) const {
+	if (p_id.idx >= m_nodes.size())
+		return false;
+
+	const Node &node = m_nodes[p_id.idx];
+	return node.generation == p_id.generation and node.list != released;
+}
+
+size_t TimerWheel::Remaining(const ID &p_id) const {
+	return Pending(p_id)? m_nodes[p_id.idx].deadline - m_now : 0;
+}
+
+size_t TimerWheel::Count() const {
+	return m_count;
+}
+
+size_t TimerWheel::Update() {
+	++ m_now;
+
+	// A level turns over only when all the levels below it did
+	for (size_t level = 1; level < TIMER_WHEEL_LEVELS; ++ level) {
+		if (m_now & ((static_cast<uint64_t>(1) << (TIMER_WHEEL_BITS * level)) - 1))
+			break;
+
+		Cascade(level);
+	}
+
+	// The whole slot is taken out at once. Timers are unlinked from it one by one, so callbacks
+	// can still cancel the ones that did not run yet
+	uint16_t list = m_now & (slots - 1);
+
+	m_heads[expiring] = m_heads[list];
+	m_heads[list]     = none;
+
+	for (uint32_t idx = m_heads[expiring]; idx != none; idx = m_nodes[idx].next)
+		m_nodes[idx].list = expiring;
+
+	size_t ended = 0;
+	while (m_heads[expiring] != none) {
+		uint32_t idx = m_heads[expiring];
+
+		// Copied out, the callback may schedule timers and grow the pool
+		Node node = m_nodes[idx];
+
+		Unlink(idx);
+		Release(idx);
+
+		node.invoke(node.callback);
+		++ ended;
+	}
+
+	return ended;
+}
+
+uint32_t TimerWheel::Acquire() {
+	uint32_t idx = m_free;
+	if (idx == none) {
+		idx = static_cast<uint32_t>(m_nodes.size());
+
+		m_nodes.emplace_back();
+	} else
+		m_free = m_nodes[idx].next;
+
+	++ m_count;
+
+	return idx;
+}
+
+void TimerWheel::Release(uint32_t p_idx) {
+	Node &node = m_nodes[p_idx];
+
+	// Old IDs of this node stop being pending
+	++ node.generation;
+	node.list = released;
+	node.next = m_free;
+
+	m_free = p_idx;
+	-- m_count;
+}
+
+void TimerWheel::Insert(uint32_t p_idx) {
+	constexpr uint64_t range = static_cast<uint64_t>(1) << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS);
+
+	// Too far away timers are put into the last slot of the wheel, from where they get
+	// cascaded and inserted again
+	uint64_t deadline = std::min(m_nodes[p_idx].deadline, m_now + range - 1);
+	uint64_t delta    = deadline - m_now;
+
+	size_t level = 0;
+	while (delta >> (TIMER_WHEEL_BITS * (level + 1)))
+		++ level;
+
+	size_t slot = (deadline >> (TIMER_WHEEL_BITS * level)) & (slots - 1);
+	Link(p_idx, static_cast<uint16_t>(level * slots + slot));
+}
+
+void TimerWheel::Link(uint32_t p_idx, uint16_t p_list) {
+	Node &node = m_nodes[p_idx];
+
+	node.list = p_list;
+	node.prev = none;
+	node.next = m_heads[p_list];
+
+	if (node.next != none)
+		m_nodes[node.next].prev = p_idx;
+
+	m_heads[p_list] = p_idx;
+}
+
+void TimerWheel::Unlink(uint32_t p_idx) {
+	Node &node = m_nodes[p_idx];
+
+	if (node.prev == none)
+		m_heads[node.list] = node.next;
+	else
+		m_nodes[node.prev].next = node.next;
+
+	if (node.next != none)
+		m_nodes[node.next].prev = node.prev;
+}
+
+void TimerWheel::Cascade(size_t p_level) {
+	size_t   slot = (m_now >> (TIMER_WHEEL_BITS * p_level)) & (slots - 1);
+	uint16_t list = static_cast<uint16_t>(p_level * slots + slot);
+
+	uint32_t idx = m_heads[list];
+	m_heads[list] = none;
+
+	// Every timer in the slot ends within this slot's span, so they all land on lower levels
+	while (idx != none) {
+		uint32_t next = m_nodes[idx].next;
+
+		Insert(idx);
+		idx = next;
+	}
+}
+
+}
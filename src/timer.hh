@@ -1,65 +1,118 @@
 #ifndef TIMER_HH__HEADER_GUARD__
 #define TIMER_HH__HEADER_GUARD__
 
-#include <functional> // std::function
+#include <vector>      // std::vector
+#include <limits>      // std::numeric_limits
+#include <algorithm>   // std::max, std::min, std::fill_n
+#include <cstdint>     // std::uint64_t, std::uint32_t, std::uint16_t
+#include <new>         // placement new
+#include <type_traits> // std::is_trivially_copyable, std::is_trivially_destructible
 
 #include "utils.hh"
 
+// Every level has 2^TIMER_WHEEL_BITS slots, each covering 2^TIMER_WHEEL_BITS times more ticks
+// than a slot of the level below
+#define TIMER_WHEEL_BITS   6
+#define TIMER_WHEEL_LEVELS 4
+
+// Callbacks are stored inside the timer, so a node takes exactly one cache line
+#define TIMER_CALLBACK_SIZE 32
+
 namespace CityBuilder {
 
-template<size_t Count>
-class TimerHandler {
+// Hierarchical timing wheel. Scheduling and cancelling are O(1), and an update only touches the
+// slot of the current tick, plus a higher level slot every 2^TIMER_WHEEL_BITS ticks, which gets
+// cascaded down. Timers further away than the wheel range (16M ticks) wait on the top level and
+// get cascaded again
+class TimerWheel {
 public:
-	using EndEvent = std::function<void()>;
-	using ID       = size_t;
-
-	struct Timer {
-		Timer(): now(0), time(0) {}
+	// Stays valid after the timer ends, it just stops being pending
+	struct ID {
+		ID(): idx(std::numeric_limits<uint32_t>::max()), generation(0) {}
+		ID(uint32_t p_idx, uint32_t p_generation): idx(p_idx), generation(p_generation) {}
 
-		size_t   now, time;
-		EndEvent envEventHandler;
+		uint32_t idx, generation;
 	};
 
-	void Init(ID p_id, size_t p_time) {
-		m_timers[p_id].time = p_time;
-	}
+	TimerWheel();
 
-	void Init(ID p_id, size_t p_time, const EndEvent &p_endEventHandler) {
-		m_timers[p_id].time            = p_time;
-		m_timers[p_id].envEventHandler = p_endEventHandler;
-	}
+	TimerWheel(TimerWheel &&p_wheel)      = default;
+	TimerWheel(const TimerWheel &p_wheel) = delete;
 
-	void Start(ID p_id) {
-		m_timers[p_id].now = m_timers[p_id].time;
-	}
+	// Calls p_callback after p_delay updates (at least 1). The callback has to be small and
+	// trivially copyable (a lambda capturing pointers and numbers), so nothing gets allocated
+	template<typename F>
+	ID Schedule(size_t p_delay, F p_callback) {
+		static_assert(sizeof(F) <= TIMER_CALLBACK_SIZE, "Timer callback captures too much");
+		static_assert(alignof(F) <= alignof(void*), "Timer callback is overaligned");
+		static_assert(std::is_trivially_copyable<F>::value and
+		              std::is_trivially_destructible<F>::value,
+		              "Timer callback has to be trivially copyable");
 
-	float GetUnit(ID p_id, bool p_reversed = false) {
-		float tmp = p_reversed? m_timers[p_id].time - m_timers[p_id].now : m_timers[p_id].now;
+		uint32_t idx  = Acquire();
+		Node    &node = m_nodes[idx];
 
-		return tmp / m_timers[p_id].time;
-	}
+		new (node.callback) F(p_callback);
+		node.invoke   = Invoke<F>;
+		node.deadline = m_now + std::max<size_t>(p_delay, 1);
 
-	size_t Get(ID p_id) {
-		return m_timers[p_id].now;
-	}
+		Insert(idx);
 
-	bool Active(ID p_id) {
-		return m_timers[p_id].now > 0;
+		return ID(idx, node.generation);
 	}
 
-	void Update() {
-		for (size_t i = 0; i < Count; ++ i) {
-			if (m_timers[i].now > 0) {
-				-- m_timers[i].now;
+	// Returns whether the timer was still pending
+	bool Cancel(const ID &p_id);
 
-				if (m_timers[i].now == 0 and m_timers[i].envEventHandler)
-					m_timers[i].envEventHandler();
-			}
-		}
-	}
+	bool   Pending(const ID &p_id) const;
+	// Updates left until the timer ends, 0 when it is not pending
+	size_t Remaining(const ID &p_id) const;
+
+	// Pending timers
+	size_t Count() const;
+
+	// Advances one tick and runs the callbacks of timers that ended, returns how many did.
+	// Callbacks may schedule and cancel timers
+	size_t Update();
 
 private:
-	Timer m_timers[Count];
+	struct Node {
+		uint64_t deadline;
+		uint32_t prev, next;
+		uint32_t generation;
+		uint16_t list;
+
+		void (*invoke)(void *p_callback);
+		alignas(void*) unsigned char callback[TIMER_CALLBACK_SIZE];
+	};
+
+	static constexpr uint32_t none  = std::numeric_limits<uint32_t>::max();
+	static constexpr size_t   slots = static_cast<size_t>(1) << TIMER_WHEEL_BITS;
+
+	// Slot lists of all the levels, then the timers ending in the current update
+	static constexpr uint16_t expiring = TIMER_WHEEL_LEVELS * slots;
+	static constexpr uint16_t released = expiring + 1;
+
+	template<typename F>
+	static void Invoke(void *p_callback) {
+		(*static_cast<F*>(p_callback))();
+	}
+
+	uint32_t Acquire();
+	void     Release(uint32_t p_idx);
+
+	void Insert(uint32_t p_idx);
+	void Link(uint32_t p_idx, uint16_t p_list);
+	void Unlink(uint32_t p_idx);
+
+	void Cascade(size_t p_level);
+
+	std::vector<Node> m_nodes;
+	uint32_t          m_free;
+	size_t            m_count;
+
+	uint32_t m_heads[expiring + 1];
+	uint64_t m_now;
 };
 
 }
@@ -10,7 +10,11 @@ UI::Layout::Layout(Type p_type, const Vec2f &p_pos, float p_padding):
 
 	type(p_type),
 	rect(p_pos, Vec2f()),
-	padding(p_padding)
+	padding(p_padding),
+
+	rowH(0),
+
+	parent(nullptr)
 {}
 
 UI::Layout::Layout(Type p_type, const Rectf &p_rect, float p_padding):
@@ -19,7 +23,11 @@ UI::Layout::Layout(Type p_type, const Rectf &p_rect, float p_padding):
 
 	type(p_type),
 	rect(p_rect),
-	padding(p_padding)
+	padding(p_padding),
+
+	rowH(0),
+
+	parent(nullptr)
 {}
 
 void UI::Layout::AddWidget(const Vec2f &p_size) {
@@ -32,7 +40,7 @@ void UI::Layout::AddWidget(const Vec2f &p_size) {
 
 	case Vert:
 		insidesSize.x  = std::max(insidesSize.x, p_size.x) + padding;
-		insidesSize.y += p_size.y + padding;
+		insidesSize.y += rowH > 0? rowH : p_size.y + padding;
 
 		break;
 
@@ -63,10 +71,32 @@ UI::Style::TextLabel::TextLabel():
 	color({Color4f(255), Color4f(0, 0, 0, 180)})
 {}
 
-UI::Style::Frame::Frame(): texture(nullptr) {}
+UI::Style::Frame::Frame():
+	texture(nullptr),
+	scrollbar(Color4f(0, 0, 0, 100))
+{}
+
+UI::Style::Graph::Graph():
+	background(Color4f(0, 0, 0, 150)),
+	bar(Color4f(255)),
+	mark(Color4f(255, 0, 0))
+{}
+
+UI::Style::Minimap::Minimap():
+	background(Color4f(0, 0, 0, 150)),
+	view(Color4f(255))
+{}
+
+UI::UI():
+	style(nullptr),
+
+	m_arena(Memory::UI),
+	m_top(nullptr),
+	m_depth(0)
+{}
 
-void UI::StyleManager::Add(const std::string &p_key, const Style &p_style) {
-	_Add(p_key, p_style);
+UI::StyleManager::Handle UI::StyleManager::Add(const std::string &p_key, const Style &p_style) {
+	return _Add(p_key, p_style);
 }
 
 void UI::ResetFocus() {
@@ -78,25 +108,35 @@ bool UI::NoFocus() {
 	return m_active.none and m_hot.none;
 }
 
+bool UI::FocusChanged() {
+	return m_active != m_settledActive or m_hot != m_settledHot;
+}
+
+void UI::SettleFocus() {
+	m_settledActive = m_active;
+	m_settledHot    = m_hot;
+}
+
 void UI::Begin(const Vec2f &p_pos, Layout::Type p_type, float p_padding) {
-	if (m_layouts.size() > 0)
+	if (m_depth > 0)
 		Panic("UI::", __FUNC__, "() called more than once");
 
+	// Nothing from the previous Begin() is alive anymore
+	m_arena.Reset();
+
 	Layout layout(p_type, p_pos, p_padding);
 	layout.viewport = Rectf(p_pos, Vec2f(SCREEN_W - p_pos.x, SCREEN_H - p_pos.y));
 
-	Game::Get().SetViewport(layout.viewport);
-
-	m_layouts.push_back(layout);
+	PushLayout(layout);
 }
 
 void UI::End() {
-	if (m_layouts.size() != 1)
+	if (m_depth != 1)
 		Panic("UI::", __FUNC__, "() called without a matching UI::Begin()");
 
-	m_layouts.pop_back();
+	PopLayout();
 
-	Game::Get().ResetViewport();
+	Game::Get().drawList.ResetClip();
 }
 
 void UI::BeginFrame(const Vec2f &p_size, Layout::Type p_type,
@@ -106,22 +146,22 @@ void UI::BeginFrame(const Vec2f &p_size, Layout::Type p_type,
 	else if (style->frame.texture == nullptr)
 		Panic("UI::", __FUNC__, "() called without setting frame.texture (it is nullptr)");
 
-	if (m_layouts.size() < 1)
+	if (m_depth < 1)
 		Panic("UI::Begin() was not called before UI::", __FUNC__, "()");
 
 	Rectf  rect(TopLayout().NextPos() + p_offset, p_size);
 	Layout layout(p_type, rect, p_padding);
 	layout.viewport = rect;
-	layout.ignore   = not NestViewportInto(layout.viewport, TopLayout().viewport);
+	layout.ignore   = not NestViewportInto(layout, TopLayout());
 
-	m_layouts.push_back(layout);
-	Game::Get().SetViewport(layout.viewport);
+	PushLayout(layout);
 
-	style->frame.texture->Render(Rectf(Vec2f(), p_size));
+	Texture &texture = *style->frame.texture;
+	DrawTexture(texture, Rectf(Vec2f(), texture.Size()), Rectf(Vec2f(), p_size));
 }
 
 void UI::EndFrame() {
-	if (m_layouts.size() <= 1)
+	if (m_depth <= 1)
 		Panic("UI::", __FUNC__, "() called without a matching UI::BeginFrame()");
 
 	if (MouseInBoundary(Rectf(Vec2f(), TopLayout().rect.Size())))
@@ -129,59 +169,129 @@ void UI::EndFrame() {
 
 	Layout &layout = TopLayout();
 
-	m_layouts.at(m_layouts.size() - 2).AddWidget(layout.rect.Size());
-	m_layouts.pop_back();
+	layout.parent->AddWidget(layout.rect.Size());
+	PopLayout();
+}
+
+UI::Rows UI::BeginScrollingFrame(ID p_id, const Vec2f &p_size, float p_rowH, size_t p_rowCount,
+                                  float p_padding, const Vec2f &p_offset) {
+	PROFILE_ZONE("UI::BeginScrollingFrame");
+
+	if (style == nullptr)
+		Panic("UI::", __FUNC__, "() called without setting style (it is nullptr)");
+	else if (style->frame.texture == nullptr)
+		Panic("UI::", __FUNC__, "() called without setting frame.texture (it is nullptr)");
+
+	if (m_depth < 1)
+		Panic("UI::Begin() was not called before UI::", __FUNC__, "()");
+
+	if (p_rowH <= 0)
+		Panic("UI::", __FUNC__, "() called with row height ", p_rowH);
+
+	Rectf  rect(TopLayout().NextPos() + p_offset, p_size);
+	Layout layout(Layout::Vert, rect, p_padding);
+	layout.viewport = rect;
+	layout.ignore   = not NestViewportInto(layout, TopLayout());
+	layout.rowH     = p_rowH;
+
+	PushLayout(layout);
+
+	Rows rows = {0, 0};
+	if (layout.ignore)
+		return rows;
+
+	Texture &texture = *style->frame.texture;
+	DrawTexture(texture, Rectf(Vec2f(), texture.Size()), Rectf(Vec2f(), p_size));
+
+	float  contentH  = p_rowCount * p_rowH + p_padding * 2;
+	float  maxScroll = std::max(contentH - p_size.y, 0.0f);
+	float &scroll    = m_scrolls[p_id];
 
-	Game::Get().SetViewport(TopLayout().viewport);
+	int wheel = Game::Get().MouseWheel();
+	if (wheel != 0 and MouseInBoundary(Rectf(Vec2f(), p_size)))
+		scroll -= wheel * UI_SCROLL_SPEED;
+
+	scroll = std::min(std::max(scroll, 0.0f), maxScroll);
+
+	if (maxScroll > 0) {
+		float barH = p_size.y * p_size.y / contentH;
+		float barY = (p_size.y - barH) * scroll / maxScroll;
+
+		DrawFill(Rectf(p_size.x - 2, barY, 2, barH), style->frame.scrollbar);
+	}
+
+	// Everything added from now on is scrolled, the rows before the visible ones are skipped
+	// over without running their widgets
+	float top = std::max(scroll - p_padding, 0.0f);
+	float bot = std::max(scroll + p_size.y - p_padding, 0.0f);
+
+	rows.first = std::min(static_cast<size_t>(std::floor(top / p_rowH)), p_rowCount);
+	rows.last  = std::min(static_cast<size_t>(std::ceil(bot / p_rowH)),  p_rowCount);
+	rows.last  = std::max(rows.first, rows.last);
+
+	TopLayout().scroll.y      += scroll;
+	TopLayout().insidesSize.y  = rows.first * p_rowH;
+
+	return rows;
+}
+
+void UI::EndScrollingFrame() {
+	if (m_depth <= 1)
+		Panic("UI::", __FUNC__, "() called without a matching UI::BeginScrollingFrame()");
+
+	Layout &layout = TopLayout();
+
+	if (not layout.ignore and MouseInBoundary(Rectf(layout.scroll, layout.viewport.Size())))
+		m_clickWasted = true;
+
+	layout.parent->AddWidget(layout.rect.Size());
+	PopLayout();
 }
 
 void UI::BeginLayout(Layout::Type p_type, float p_padding, const Vec2f &p_offset) {
-	if (m_layouts.size() < 1)
+	if (m_depth < 1)
 		Panic("UI::Begin() was not called before UI::", __FUNC__, "()");
 
 	Layout layout(p_type, TopLayout().NextPos() + p_offset, p_padding);
 	layout.viewport = Rectf(layout.rect.Pos(), TopLayout().viewport.Size());
-	layout.ignore   = not NestViewportInto(layout.viewport, TopLayout().viewport);
+	layout.ignore   = not NestViewportInto(layout, TopLayout());
 
-	m_layouts.push_back(layout);
-	Game::Get().SetViewport(layout.viewport);
+	PushLayout(layout);
 }
 
 void UI::EndLayout() {
-	if (m_layouts.size() <= 1)
+	if (m_depth <= 1)
 		Panic("UI::", __FUNC__, "() called without a matching UI::BeginLayout()");
 
 	Layout &layout = TopLayout();
 
-	m_layouts.at(m_layouts.size() - 2).AddWidget(layout.insidesSize);
-	m_layouts.pop_back();
-
-	Game::Get().SetViewport(TopLayout().viewport);
+	layout.parent->AddWidget(layout.insidesSize);
+	PopLayout();
 }
 
 void UI::BeginFloating(Layout::Type p_type, const Vec2f &p_pos,
 	                   float p_padding, const Vec2f &p_offset) {
-	if (m_layouts.size() < 1)
+	if (m_depth < 1)
 		Panic("UI::Begin() was not called before UI::", __FUNC__, "()");
 
 	Layout layout(p_type, p_pos + p_offset, p_padding);
 	layout.viewport = Rectf(layout.rect.Pos(), TopLayout().viewport.Size());
-	layout.ignore   = not NestViewportInto(layout.viewport, TopLayout().viewport);
+	layout.ignore   = not NestViewportInto(layout, TopLayout());
 
-	m_layouts.push_back(layout);
-	Game::Get().SetViewport(layout.viewport);
+	PushLayout(layout);
 }
 
 void UI::EndFloating() {
-	if (m_layouts.size() <= 1)
+	if (m_depth <= 1)
 		Panic("UI::", __FUNC__, "() called without a matching UI::BeginFloating()");
 
-	m_layouts.pop_back();
-	Game::Get().SetViewport(TopLayout().viewport);
+	PopLayout();
 }
 
 bool UI::TextButton(ID p_id, const Vec2f &p_size, const std::string &p_text,
                     float p_textScale, const Vec2f &p_offset, bool p_active) {
+	PROFILE_ZONE("UI::TextButton");
+
 	if (style == nullptr)
 		Panic("UI::", __FUNC__, "() called without setting style (it is nullptr)");
 	else if (style->font == nullptr)
@@ -189,7 +299,7 @@ bool UI::TextButton(ID p_id, const Vec2f &p_size, const std::string &p_text,
 	else if (style->textButton.texture == nullptr)
 		Panic("UI::", __FUNC__, "() called without setting textButton.texture (it is nullptr)");
 
-	if (m_layouts.size() < 1)
+	if (m_depth < 1)
 		Panic("UI::Begin() was not called before UI::", __FUNC__, "()");
 
 	Layout &layout = TopLayout();
@@ -221,6 +331,9 @@ bool UI::TextButton(ID p_id, const Vec2f &p_size, const std::string &p_text,
 			m_hot.none = true;
 	}
 
+	if (not Visible(rect))
+		return clicked;
+
 	Style::TextButton::State state;
 	if (m_active == p_id)
 		state = Style::TextButton::Click;
@@ -237,25 +350,22 @@ bool UI::TextButton(ID p_id, const Vec2f &p_size, const std::string &p_text,
 	src.h /= 3;
 	src.y  = src.h * (m_active == p_id? 2 : (m_hot == p_id? 1 : 0));
 
-	texture->Render(src, rect);
+	DrawTexture(*texture, src, rect);
 
-	auto rendered = Game::Get().textRenderer.Render(p_text, *style->font);
-	if (not rendered.Ok())
-		Panic(rendered);
+	Vec2f size = Game::Get().textRenderer.Measure(p_text, *style->font) * p_textScale;
+	Vec2f pos  = Vec2f(rect.w / 2 - size.x / 2 + rect.x,
+	                   rect.h / 2 - size.y / 2 + rect.y) + textOffset;
 
-	Vec2f size = static_cast<Vec2f>(rendered.Value()->Size()) * p_textScale;
-	Rectf dest = Rectf(Vec2f(rect.w / 2 - size.x / 2 + rect.x,
-	                         rect.h / 2 - size.y / 2 + rect.y) + textOffset, size);
-
-	rendered.Value()->SetColor(color);
-	rendered.Value()->Render(dest);
+	DrawText(p_text, pos, p_textScale, color);
 
 	return clicked;
 }
 
 bool UI::ImageButton(ID p_id, const Vec2f &p_size, Texture &p_texture,
                      const Vec2f &p_offset, bool p_active) {
-	if (m_layouts.size() < 1)
+	PROFILE_ZONE("UI::ImageButton");
+
+	if (m_depth < 1)
 		Panic("UI::Begin() was not called before UI::", __FUNC__, "()");
 
 	Layout &layout = TopLayout();
@@ -287,51 +397,56 @@ bool UI::ImageButton(ID p_id, const Vec2f &p_size, Texture &p_texture,
 			m_hot.none = true;
 	}
 
+	if (not Visible(rect))
+		return clicked;
+
 	Rectf src(Vec2f(), p_texture.Size());
 	src.h /= 3;
 	src.y  = src.h * (m_active == p_id? 2 : (m_hot == p_id? 1 : 0));
 
-	p_texture.Render(src, rect);
+	DrawTexture(p_texture, src, rect);
 
 	return clicked;
 }
 
 void UI::TextLabel(const std::string &p_text, float p_scale, const Vec2f &p_offset,
                    size_t p_lineChLimit) {
+	PROFILE_ZONE("UI::TextLabel");
+
 	if (style == nullptr)
 		Panic("UI::", __FUNC__, "() called without setting style (it is nullptr)");
 	else if (style->font == nullptr)
 		Panic("UI::", __FUNC__, "() called without setting font (it is nullptr)");
 
-	if (m_layouts.size() < 1)
+	if (m_depth < 1)
 		Panic("UI::Begin() was not called before UI::", __FUNC__, "()");
 
 	Layout &layout = TopLayout();
 	if (layout.ignore)
 		return;
 
-	auto rendered = Game::Get().textRenderer.Render(p_text, *style->font,
-	                                                Color4f(255), p_lineChLimit);
-	if (not rendered.Ok())
-		Panic(rendered);
-
-	Rectf rect(layout.NextPos() + p_offset, static_cast<Vec2f>(rendered.Value()->Size()) * p_scale);
+	Rectf rect(layout.NextPos() + p_offset,
+	           Game::Get().textRenderer.Measure(p_text, *style->font, p_lineChLimit) * p_scale);
 
 	layout.AddWidget(rect.Size() + p_offset);
 
+	if (not Visible(rect))
+		return;
+
 	Color4f &shadowColor = style->textLabel.color[Style::TextLabel::Shadow];
-	if (shadowColor.a > 0) {
-		rendered.Value()->SetColor(shadowColor);
-		rendered.Value()->Render(Rectf(rect.Pos() + style->textLabel.shadowOffset, rect.Size()));
-	}
+	if (shadowColor.a > 0)
+		DrawText(p_text, rect.Pos() + style->textLabel.shadowOffset, p_scale, shadowColor,
+		         p_lineChLimit);
 
-	rendered.Value()->SetColor(style->textLabel.color[Style::TextLabel::Text]);
-	rendered.Value()->Render(rect);
+	DrawText(p_text, rect.Pos(), p_scale, style->textLabel.color[Style::TextLabel::Text],
+	         p_lineChLimit);
 }
 
 void UI::ImageLabel(Texture &p_texture, size_t p_frames, size_t p_frame,
                     float p_scale, const Vec2f &p_offset) {
-	if (m_layouts.size() < 1)
+	PROFILE_ZONE("UI::ImageLabel");
+
+	if (m_depth < 1)
 		Panic("UI::Begin() was not called before UI::", __FUNC__, "()");
 
 	Layout &layout = TopLayout();
@@ -341,11 +456,128 @@ void UI::ImageLabel(Texture &p_texture, size_t p_frames, size_t p_frame,
 	Rectf rect(layout.NextPos() + p_offset, static_cast<Vec2f>(p_texture.Size()) * p_scale);
 	layout.AddWidget(rect.Size() + p_offset);
 
+	if (not Visible(rect))
+		return;
+
 	Rectf src(Vec2f(), p_texture.Size());
 	src.h /= p_frames;
 	src.y  = src.h * p_frame;
 
-	p_texture.Render(src, rect);
+	DrawTexture(p_texture, src, rect);
+}
+
+void UI::Graph(const float *p_values, size_t p_count, float p_max, const Vec2f &p_size,
+               float p_mark, const Vec2f &p_offset) {
+	PROFILE_ZONE("UI::Graph");
+
+	if (style == nullptr)
+		Panic("UI::", __FUNC__, "() called without setting style (it is nullptr)");
+
+	if (m_depth < 1)
+		Panic("UI::Begin() was not called before UI::", __FUNC__, "()");
+
+	Layout &layout = TopLayout();
+	if (layout.ignore)
+		return;
+
+	Rectf rect(layout.NextPos() + p_offset, p_size);
+	layout.AddWidget(rect.Size() + p_offset);
+
+	if (not Visible(rect))
+		return;
+
+	DrawFill(rect, style->graph.background);
+
+	if (p_count == 0 or p_max <= 0)
+		return;
+
+	float barW = rect.w / p_count;
+	for (size_t i = 0; i < p_count; ++ i) {
+		float barH = std::min(p_values[i] / p_max, 1.0f) * rect.h;
+
+		DrawFill(Rectf(rect.x + barW * i, rect.y + rect.h - barH, barW, barH), style->graph.bar);
+	}
+
+	if (p_mark > 0 and p_mark <= p_max)
+		DrawFill(Rectf(rect.x, rect.y + rect.h - p_mark / p_max * rect.h, rect.w, 1),
+		         style->graph.mark);
+}
+
+bool UI::Minimap(ID p_id, const Texture &p_texture, const Vec2f &p_size, const Vec2f *p_corners,
+                 const Rectf &p_view, Vec2f &p_mouse, const Vec2f &p_offset) {
+	PROFILE_ZONE("UI::Minimap");
+
+	if (style == nullptr)
+		Panic("UI::", __FUNC__, "() called without setting style (it is nullptr)");
+
+	if (m_depth < 1)
+		Panic("UI::Begin() was not called before UI::", __FUNC__, "()");
+
+	Layout &layout = TopLayout();
+	if (layout.ignore)
+		return false;
+
+	Rectf rect(layout.NextPos() + p_offset, p_size);
+	layout.AddWidget(rect.Size() + p_offset);
+
+	// Stays held while dragging outside of it, so the camera keeps following the mouse
+	bool held = false;
+	if (m_active == p_id) {
+		if (MousePressed(MouseButton::Left))
+			held = true;
+		else
+			m_active.none = true;
+	} else if (m_hot == p_id) {
+		if (not MouseInBoundary(rect))
+			m_hot.none = true;
+		else if (m_active.none and MousePressed(MouseButton::Left)) {
+			m_active = p_id;
+			held     = true;
+		}
+	} else if (m_hot.none and MouseInBoundary(rect))
+		m_hot = p_id;
+
+	if (held) {
+		Vec2f mouse = static_cast<Vec2f>(Game::Get().MousePos()) - layout.viewport.Pos().Round() +
+		              layout.scroll.Round();
+
+		p_mouse = mouse - rect.Pos();
+	}
+
+	if (not Visible(rect))
+		return held;
+
+	DrawFill(rect, style->minimap.background);
+
+	Rectf dest = ToScreen(rect);
+	Vec2f raw  = p_texture.RawSize();
+	Vec2f uv0  = static_cast<Vec2f>(p_texture.region.Pos()) / raw;
+	Vec2f uv1  = uv0 + static_cast<Vec2f>(p_texture.Size()) / raw;
+
+	DrawList &drawList = Game::Get().drawList;
+	drawList.SetClip(layout.viewport.Round());
+
+	SDL_Vertex *quad  = drawList.AddQuads(p_texture.raw, 1, dest);
+	SDL_Color   color = Color4i(255);
+
+	quad[0] = {{dest.x + p_corners[0].x, dest.y + p_corners[0].y}, color, {uv0.x, uv0.y}};
+	quad[1] = {{dest.x + p_corners[1].x, dest.y + p_corners[1].y}, color, {uv1.x, uv0.y}};
+	quad[2] = {{dest.x + p_corners[2].x, dest.y + p_corners[2].y}, color, {uv1.x, uv1.y}};
+	quad[3] = {{dest.x + p_corners[3].x, dest.y + p_corners[3].y}, color, {uv0.x, uv1.y}};
+
+	// Outlined only where it is inside of the widget
+	float left   = std::max(p_view.x, 0.0f),            top    = std::max(p_view.y, 0.0f);
+	float right  = std::min(p_view.x + p_view.w, rect.w), bottom = std::min(p_view.y + p_view.h, rect.h);
+	if (right - left < 1 or bottom - top < 1)
+		return held;
+
+	const Color4i &view = style->minimap.view;
+	DrawFill(Rectf(rect.x + left,      rect.y + top,        right - left, 1),          view);
+	DrawFill(Rectf(rect.x + left,      rect.y + bottom - 1, right - left, 1),          view);
+	DrawFill(Rectf(rect.x + left,      rect.y + top,        1,            bottom - top), view);
+	DrawFill(Rectf(rect.x + right - 1, rect.y + top,        1,            bottom - top), view);
+
+	return held;
 }
 
 bool UI::Screen(ID p_id) {
@@ -363,10 +595,11 @@ bool UI::Screen(ID p_id) {
 }
 
 bool UI::MouseInBoundary(const Rectf &p_rect) {
-	Vec2i mouse = Game::Get().MousePos();
+	Layout &layout = TopLayout();
+	Vec2i   mouse  = Game::Get().MousePos() - static_cast<Vec2i>(layout.viewport.Pos().Round());
 
-	if (mouse.x < TopLayout().viewport.w and mouse.y < TopLayout().viewport.h)
-		return p_rect.Touches(mouse);
+	if (mouse.x < layout.viewport.w and mouse.y < layout.viewport.h)
+		return p_rect.Touches(mouse + static_cast<Vec2i>(layout.scroll.Round()));
 	else
 		return false;
 }
@@ -375,24 +608,92 @@ bool UI::MousePressed(MouseButton p_button) {
 	return Game::Get().MousePressed() == p_button;
 }
 
-bool UI::NestViewportInto(Rectf &p_a, const Rectf &p_b) {
-	if (p_a.x >= p_b.w or p_a.y >= p_b.h or
-	    p_a.x + p_a.w < 0 or p_a.y + p_a.h < 0)
+bool UI::NestViewportInto(Layout &p_layout, const Layout &p_parent) {
+	Rectf       &a = p_layout.viewport;
+	const Rectf &b = p_parent.viewport;
+
+	a.x -= p_parent.scroll.x;
+	a.y -= p_parent.scroll.y;
+
+	if (a.x >= b.w or a.y >= b.h or
+	    a.x + a.w < 0 or a.y + a.h < 0)
 		return false;
 
-	if (p_a.x + p_a.w > p_b.w)
-		p_a.w = p_b.w - p_a.x;
-	if (p_a.y + p_a.h > p_b.h)
-		p_a.h = p_b.h - p_a.y;
+	// Whatever sticks out before the parent gets cut, the insides keep their place by scrolling
+	if (a.x < 0) {
+		p_layout.scroll.x -= a.x;
 
-	p_a.x += p_b.x;
-	p_a.y += p_b.y;
+		a.w += a.x;
+		a.x  = 0;
+	}
+	if (a.y < 0) {
+		p_layout.scroll.y -= a.y;
+
+		a.h += a.y;
+		a.y  = 0;
+	}
+
+	if (a.x + a.w > b.w)
+		a.w = b.w - a.x;
+	if (a.y + a.h > b.h)
+		a.h = b.h - a.y;
+
+	a.x += b.x;
+	a.y += b.y;
 
 	return true;
 }
 
+Rectf UI::ToScreen(const Rectf &p_rect) {
+	// Same rounding the SDL viewports used to do, positions inside get truncated
+	Recti rect   = p_rect;
+	Vec2f offset = TopLayout().viewport.Pos().Round() - TopLayout().scroll.Round();
+
+	return Rectf(static_cast<Vec2f>(rect.Pos()) + offset, rect.Size());
+}
+
+void UI::DrawTexture(const Texture &p_texture, const Rectf &p_src, const Rectf &p_dest) {
+	DrawList &drawList = Game::Get().drawList;
+
+	drawList.SetClip(TopLayout().viewport.Round());
+	drawList.Quad(p_texture, p_src, ToScreen(p_dest));
+}
+
+void UI::DrawFill(const Rectf &p_dest, const Color4i &p_color) {
+	DrawList &drawList = Game::Get().drawList;
+
+	drawList.SetClip(TopLayout().viewport.Round());
+	drawList.Fill(ToScreen(p_dest), p_color);
+}
+
+void UI::DrawText(const std::string &p_text, const Vec2f &p_pos, float p_scale,
+                  const Color4i &p_color, size_t p_lineChLimit) {
+	DrawList &drawList = Game::Get().drawList;
+
+	drawList.SetClip(TopLayout().viewport.Round());
+	Game::Get().textRenderer.Draw(drawList, p_text, *style->font, ToScreen(Rectf(p_pos)).Pos(),
+	                              p_scale, p_color, p_lineChLimit);
+}
+
+bool UI::Visible(const Rectf &p_rect) {
+	return ToScreen(p_rect).Touches(TopLayout().viewport);
+}
+
+void UI::PushLayout(const Layout &p_layout) {
+	Layout *layout = m_arena.New<Layout>(p_layout);
+	layout->parent = m_top;
+
+	m_top = layout;
+	++ m_depth;
+}
+
+void UI::PopLayout() {
+	m_top = m_top->parent;
+	-- m_depth;
+}
+
 UI::Layout &UI::TopLayout() {
-	return m_layouts.at(m_layouts.size() - 1);
+	return *m_top;
 }
 
 }
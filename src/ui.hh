@@ -1,20 +1,25 @@
 #ifndef UI_HH__HEADER_GUARD__
 #define UI_HH__HEADER_GUARD__
 
-#include <vector> // std::vector
-#include <string> // std::string
-#include <cmath>  // std::max
+#include <string>        // std::string
+#include <cmath>         // std::max, std::floor, std::ceil
+#include <unordered_map> // std::unordered_map
 
 #include "utils.hh"
 #include "units.hh"
 #include "texture.hh"
 #include "manager.hh"
+#include "draw_list.hh"
+#include "arena.hh"
 
 #include "text/font.hh"
 #include "text/text_renderer.hh"
 
 #define UI_ID_SCREEN static_cast<CityBuilder::UI::ID>(-1)
 
+// Pixels scrolled per mouse wheel step
+#define UI_SCROLL_SPEED 16
+
 namespace CityBuilder {
 
 enum MouseButton {
@@ -45,6 +50,19 @@ public:
 		Rectf rect, viewport;
 		Vec2f insidesSize;
 		float padding;
+
+		// Where the insides start relative to the viewport, so they can be scrolled or start
+		// before the viewport when it got cut by the parent
+		Vec2f scroll;
+		// When not 0, every widget takes exactly one row of this height (scrolling frames)
+		float rowH;
+
+		Layout *parent;
+	};
+
+	// Rows [first, last) of a scrolling frame that are visible
+	struct Rows {
+		size_t first, last;
 	};
 
 	struct Style {
@@ -86,22 +104,36 @@ public:
 			Frame();
 
 			Texture *texture;
+			Color4f  scrollbar;
 		} frame;
+
+		struct Graph {
+			Graph();
+
+			Color4f background, bar, mark;
+		} graph;
+
+		struct Minimap {
+			Minimap();
+
+			Color4f background, view;
+		} minimap;
 	};
 
 	class StyleManager : public Manager<Style, std::string> {
 	public:
-		void Add(const std::string &p_key, const Style &p_style);
+		Handle Add(const std::string &p_key, const Style &p_style);
 	};
 
-	UI(): style(nullptr) {}
-
-	// TODO: Make BeginScrollingFrame and EndScrollingFrame, give layouts relative starting point
-	// so scrolling frames work
+	UI();
 
 	void ResetFocus();
 	bool NoFocus();
 
+	// Whether the hot/active widget changed since the last SettleFocus()
+	bool FocusChanged();
+	void SettleFocus();
+
 	void Begin(const Vec2f &p_pos = Vec2f(),
 	           Layout::Type p_type = Layout::Horiz, float p_padding = 0);
 	void End();
@@ -110,6 +142,12 @@ public:
 	                float p_padding = 0, const Vec2f &p_offset = Vec2f(0));
 	void EndFrame();
 
+	// A vertical frame of p_rowCount rows of p_rowH height, scrolled with the mouse wheel. Only
+	// the returned visible rows should be added, each widget added directly takes one row
+	Rows BeginScrollingFrame(ID p_id, const Vec2f &p_size, float p_rowH, size_t p_rowCount,
+	                         float p_padding = 0, const Vec2f &p_offset = Vec2f(0));
+	void EndScrollingFrame();
+
 	void BeginLayout(Layout::Type p_type, float p_padding = 0,
 	                 const Vec2f &p_offset = Vec2f(0));
 	void EndLayout();
@@ -128,6 +166,17 @@ public:
 	void ImageLabel(Texture &p_texture, size_t p_frames = 1, size_t p_frame = 0,
 	                float p_scale = 1, const Vec2f &p_offset = Vec2f(0));
 
+	// A bar for each value, p_max fills the whole height. When p_mark is not 0, a line is drawn
+	// at that value
+	void Graph(const float *p_values, size_t p_count, float p_max, const Vec2f &p_size,
+	           float p_mark = 0, const Vec2f &p_offset = Vec2f(0));
+
+	// p_texture stretched over the quad p_corners (relative to the widget, clockwise from the
+	// texture top left), with p_view outlined on top. Returns whether the left mouse button is
+	// held on it, p_mouse is then the mouse position relative to the widget
+	bool Minimap(ID p_id, const Texture &p_texture, const Vec2f &p_size, const Vec2f *p_corners,
+	             const Rectf &p_view, Vec2f &p_mouse, const Vec2f &p_offset = Vec2f(0));
+
 	bool Screen(ID p_id = UI_ID_SCREEN);
 
 	Style *style;
@@ -137,15 +186,35 @@ private:
 	bool MouseInBoundary(const Rectf &p_rect);
 	bool MousePressed(MouseButton p_button);
 
-	bool NestViewportInto(Rectf &p_a, const Rectf &p_b);
+	bool NestViewportInto(Layout &p_layout, const Layout &p_parent);
+
+	// Everything is recorded into Game::drawList, positioned and clipped by the top layout
+	// viewport, instead of setting an SDL viewport for every layout
+	Rectf ToScreen(const Rectf &p_rect);
+	void  DrawTexture(const Texture &p_texture, const Rectf &p_src, const Rectf &p_dest);
+	void  DrawFill(const Rectf &p_dest, const Color4i &p_color);
+	void  DrawText(const std::string &p_text, const Vec2f &p_pos, float p_scale,
+	               const Color4i &p_color, size_t p_lineChLimit = TEXT_LINE_CH_LIMIT_NONE);
+
+	// Widgets completely outside the top layout viewport still take space, but draw nothing
+	bool Visible(const Rectf &p_rect);
+
+	// Layouts live in the arena until the next Begin(), they are linked to their parents
+	void PushLayout(const Layout &p_layout);
+	void PopLayout();
 
 	Layout &TopLayout();
 
 	bool m_clickWasted;
 
 	Maybe<ID> m_active, m_hot;
+	Maybe<ID> m_settledActive, m_settledHot;
+
+	FrameArena m_arena;
+	Layout    *m_top;
+	size_t     m_depth;
 
-	std::vector<Layout> m_layouts;
+	std::unordered_map<ID, float> m_scrolls;
 };
 
 }
@@ -244,9 +244,6 @@ struct Maybe {
 	}
 };
 
-Maybe<std::string> ReadFile(const std::string &p_path);
-Error WriteFile(const std::string &p_path, const std::string &p_content);
-
 std::string Trim(const std::string &p_str);
 
 }
@@ -0,0 +1,118 @@
+#include "command.hh"
+
+namespace CityBuilder {
+
+Command::Command():
+	type(Type::Build),
+	tileType(Tile::Grass),
+	dir(Dir::Up),
+	steps(0)
+{}
+
+Command Command::Build(const Vec2i &p_tile, Tile::Type p_tileType) {
+	Command command;
+	command.type     = Type::Build;
+	command.tile     = p_tile;
+	command.tileType = p_tileType;
+
+	return command;
+}
+
+Command Command::Demolish(const Vec2i &p_tile) {
+	Command command;
+	command.type = Type::Demolish;
+	command.tile = p_tile;
+
+	return command;
+}
+
+Command Command::FillRect(const Vec2i &p_from, const Vec2i &p_to, Tile::Type p_tileType) {
+	Command command;
+	command.type     = Type::FillRect;
+	command.tile     = p_from;
+	command.to       = p_to;
+	command.tileType = p_tileType;
+
+	return command;
+}
+
+Command Command::Line(const Vec2i &p_from, const Vec2i &p_to, Tile::Type p_tileType) {
+	Command command;
+	command.type     = Type::Line;
+	command.tile     = p_from;
+	command.to       = p_to;
+	command.tileType = p_tileType;
+
+	return command;
+}
+
+Command Command::FloodFill(const Vec2i &p_tile, Tile::Type p_tileType) {
+	Command command;
+	command.type     = Type::FloodFill;
+	command.tile     = p_tile;
+	command.tileType = p_tileType;
+
+	return command;
+}
+
+Command Command::PanCamera(Dir p_dir) {
+	Command command;
+	command.type = Type::PanCamera;
+	command.dir  = p_dir;
+
+	return command;
+}
+
+Command Command::DragCamera(const Vec2f &p_off) {
+	Command command;
+	command.type = Type::DragCamera;
+	command.off  = p_off;
+
+	return command;
+}
+
+Command Command::ZoomCamera(int p_steps) {
+	Command command;
+	command.type  = Type::ZoomCamera;
+	command.steps = p_steps;
+
+	return command;
+}
+
+Command Command::JumpCamera(const Vec2f &p_pos) {
+	Command command;
+	command.type = Type::JumpCamera;
+	command.pos  = p_pos;
+
+	return command;
+}
+
+Command Command::BeginEdit() {
+	Command command;
+	command.type = Type::BeginEdit;
+
+	return command;
+}
+
+Command Command::EndEdit() {
+	Command command;
+	command.type = Type::EndEdit;
+
+	return command;
+}
+
+Command Command::Undo() {
+	Command command;
+	command.type = Type::Undo;
+
+	return command;
+}
+
+Command Command::Redo() {
+	Command command;
+	command.type = Type::Redo;
+
+	return command;
+}
+
+}
@@ -0,0 +1,67 @@
+#ifndef COMMAND_HH__HEADER_GUARD__
+#define COMMAND_HH__HEADER_GUARD__
+
+#include "../units.hh"
+
+#include "tile.hh"
+
+namespace CityBuilder {
+
+// Everything input asks the simulation to do. Plain data, so it can be queued between threads
+struct Command {
+	enum class Type : uint8_t {
+		Build = 0,
+		Demolish,
+		FillRect,
+		Line,
+		FloodFill,
+		PanCamera,
+		DragCamera,
+		ZoomCamera,
+		JumpCamera,
+		BeginEdit,
+		EndEdit,
+		Undo,
+		Redo
+	};
+
+	static Command Build(const Vec2i &p_tile, Tile::Type p_tileType);
+	static Command Demolish(const Vec2i &p_tile);
+
+	// Area edits, each applied at once and undone as one step. The corners and line ends can
+	// be outside of the world
+	static Command FillRect(const Vec2i &p_from, const Vec2i &p_to, Tile::Type p_tileType);
+	static Command Line(const Vec2i &p_from, const Vec2i &p_to, Tile::Type p_tileType);
+	// Everything connected to p_tile with the same type
+	static Command FloodFill(const Vec2i &p_tile, Tile::Type p_tileType);
+
+	static Command PanCamera(Dir p_dir);
+	// p_off is in screen pixels
+	static Command DragCamera(const Vec2f &p_off);
+	// Positive zooms in
+	static Command ZoomCamera(int p_steps);
+	// Sets Camera::pos
+	static Command JumpCamera(const Vec2f &p_pos);
+
+	// Edits between these are undone together
+	static Command BeginEdit();
+	static Command EndEdit();
+
+	static Command Undo();
+	static Command Redo();
+
+	Command();
+
+	Type type;
+
+	Vec2i      tile, to;
+	Tile::Type tileType;
+
+	Dir   dir;
+	Vec2f off, pos;
+	int   steps;
+};
+
+}
+
+#endif
@@ -0,0 +1,130 @@
+#include "journal.hh"
+
+namespace CityBuilder {
+
+#define JOURNAL_CAN_PLACE_ON 0x80
+
+Journal::State Journal::Pack(const Tile &p_tile) {
+	return static_cast<State>(p_tile.type) | (p_tile.canPlaceOn? JOURNAL_CAN_PLACE_ON : 0);
+}
+
+Tile Journal::Unpack(State p_state) {
+	return Tile(static_cast<Tile::Type>(p_state & ~JOURNAL_CAN_PLACE_ON),
+	            p_state & JOURNAL_CAN_PLACE_ON);
+}
+
+Journal::Journal(size_t p_cap):
+	m_cap(p_cap),
+	m_cursor(0),
+	m_cursorRun(0),
+	m_open(false),
+	m_started(false),
+	m_overflow(false)
+{}
+
+void Journal::Clear() {
+	m_runs.clear();
+	m_steps.clear();
+
+	m_cursor    = 0;
+	m_cursorRun = 0;
+	m_open      = false;
+	m_started   = false;
+	m_overflow  = false;
+}
+
+void Journal::Begin() {
+	End();
+
+	m_open = true;
+}
+
+void Journal::End() {
+	if (not m_open)
+		return;
+
+	m_open = false;
+
+	if (not m_started)
+		return;
+
+	m_started  = false;
+	m_overflow = false;
+
+	// Only an edit too big to be kept leaves the step empty
+	if (m_steps.back() == 0) {
+		m_steps.pop_back();
+
+		return;
+	}
+
+	++ m_cursor;
+	m_cursorRun = m_runs.size();
+}
+
+void Journal::Record(const Vec2i &p_tile, State p_before, State p_after) {
+	if (p_before == p_after)
+		return;
+
+	bool single = not m_open;
+	if (single)
+		Begin();
+
+	// The step starts with its first change, so edits that change nothing keep the redo steps
+	if (not m_started) {
+		m_runs.resize(m_cursorRun);
+		m_steps.resize(m_cursor);
+
+		m_steps.push_back(0);
+		m_started = true;
+	}
+
+	if (not m_overflow) {
+		// Drags mostly go along a row, which keeps extending the last run
+		Run *last = m_steps.back() > 0? &m_runs.back() : nullptr;
+		if (last != nullptr and last->y == p_tile.y and
+		    last->x + static_cast<int32_t>(last->count) == p_tile.x and
+		    last->before == p_before and last->after == p_after)
+			++ last->count;
+		else {
+			m_runs.push_back({p_tile.x, p_tile.y, 1, p_before, p_after});
+			++ m_steps.back();
+		}
+
+		Trim();
+	}
+
+	if (single)
+		End();
+}
+
+size_t Journal::Bytes() const {
+	return m_runs.size() * sizeof(Run) + m_steps.size() * sizeof(size_t);
+}
+
+void Journal::Trim() {
+	while (Bytes() > m_cap) {
+		// The step being recorded is the only one left, it can not be undone as a whole anymore
+		if (m_steps.size() == 1 and m_started) {
+#ifdef CITY_BUILDER_LOG
+			Log("Edit is too big for the undo journal, it can not be undone");
+#endif
+
+			m_runs.clear();
+			m_steps.back() = 0;
+			m_overflow     = true;
+
+			return;
+		}
+
+		size_t runs = m_steps.front();
+
+		m_runs.erase(m_runs.begin(), m_runs.begin() + runs);
+		m_steps.pop_front();
+
+		-- m_cursor;
+		m_cursorRun -= runs;
+	}
+}
+
+}
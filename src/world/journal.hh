@@ -0,0 +1,102 @@
+#ifndef JOURNAL_HH__HEADER_GUARD__
+#define JOURNAL_HH__HEADER_GUARD__
+
+#include <cstdint> // std::int32_t, std::uint32_t, std::uint8_t
+
+#include "../utils.hh"
+#include "../units.hh"
+#include "../memory.hh"
+
+#include "../main/config.hh"
+
+#include "tile.hh"
+
+namespace CityBuilder {
+
+// Undo history of tile edits. Every change is stored as a run of neighbouring tiles in a row that
+// went from the same state to the same state, so painting along a row or filling an area takes a
+// run per row instead of a copy of the world. Edits between Begin() and End() (a whole drag) are
+// undone as one step
+class Journal {
+public:
+	// What a tile gets restored to, the type and whether it can be built on
+	using State = uint8_t;
+
+	struct Run {
+		int32_t  x, y;
+		uint32_t count;
+		State    before, after;
+	};
+
+	static State Pack(const Tile &p_tile);
+	static Tile  Unpack(State p_state);
+
+	Journal(size_t p_cap = JOURNAL_MEMORY_CAP);
+
+	// Forgets all the steps
+	void Clear();
+
+	void Begin();
+	void End();
+
+	// Outside of Begin() and End(), the edit is a step on its own. Drops the steps that could be
+	// redone
+	void Record(const Vec2i &p_tile, State p_before, State p_after);
+
+	// Call p_restore(run, state) for every run of the step, newest first for undo. Return whether
+	// there was a step to undo/redo
+	template<typename F>
+	bool Undo(F p_restore) {
+		End();
+
+		if (m_cursor == 0)
+			return false;
+
+		size_t first = m_cursorRun - m_steps[m_cursor - 1];
+		for (size_t i = m_cursorRun; i -- > first;)
+			p_restore(m_runs[i], m_runs[i].before);
+
+		-- m_cursor;
+		m_cursorRun = first;
+
+		return true;
+	}
+
+	template<typename F>
+	bool Redo(F p_restore) {
+		End();
+
+		if (m_cursor == m_steps.size())
+			return false;
+
+		size_t last = m_cursorRun + m_steps[m_cursor];
+		for (size_t i = m_cursorRun; i < last; ++ i)
+			p_restore(m_runs[i], m_runs[i].after);
+
+		++ m_cursor;
+		m_cursorRun = last;
+
+		return true;
+	}
+
+	size_t Bytes() const;
+
+private:
+	// Drops the oldest steps until the journal fits into the cap again
+	void Trim();
+
+	size_t m_cap;
+
+	TrackedDeque<Run,    Memory::Journal> m_runs;
+	TrackedDeque<size_t, Memory::Journal> m_steps; // Runs per step
+
+	// Steps before the cursor can be undone, the ones after it redone
+	size_t m_cursor, m_cursorRun;
+
+	// Between Begin() and End(), the step was pushed, the step got too big to be kept
+	bool m_open, m_started, m_overflow;
+};
+
+}
+
+#endif
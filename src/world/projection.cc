@@ -0,0 +1,54 @@
+#include "projection.hh"
+
+namespace CityBuilder {
+
+Projection::Projection(const Camera &p_camera):
+	w(static_cast<float>(TILE_W) * p_camera.zoom),
+	h(static_cast<float>(TILE_H) * p_camera.zoom),
+
+	offX((p_camera.pos.x + TILE_W / 2) * p_camera.zoom - static_cast<float>(SCREEN_W) / 2),
+	offY(p_camera.pos.y * p_camera.zoom - static_cast<float>(SCREEN_H) / 2),
+
+	m_halfW(std::llround(static_cast<double>(w) / 2 * PROJECTION_ONE)),
+	m_halfH(std::llround(static_cast<double>(h) / 2 * PROJECTION_ONE)),
+	m_offX(std::llround(static_cast<double>(offX) * PROJECTION_ONE)),
+	m_offY(std::llround(static_cast<double>(offY) * PROJECTION_ONE))
+{}
+
+Recti Projection::TileRect(int32_t p_x, int32_t p_y) const {
+	int64_t left = (static_cast<int64_t>(p_x) - p_y) * m_halfW - m_offX;
+	int64_t top  = (static_cast<int64_t>(p_x) + p_y) * m_halfH - m_offY;
+
+	int32_t x = Snap(left), y = Snap(top);
+
+	return Recti(x, y, Snap(left + m_halfW * 2) - x, Snap(top + m_halfH * 2) - y);
+}
+
+void Projection::RowRects(int32_t p_x, int32_t p_y, size_t p_count, Recti *p_rects) const {
+	int64_t left = (static_cast<int64_t>(p_x) - p_y) * m_halfW - m_offX;
+	int64_t top  = (static_cast<int64_t>(p_x) + p_y) * m_halfH - m_offY;
+
+	for (size_t i = 0; i < p_count; ++ i) {
+		int32_t x = Snap(left), y = Snap(top);
+
+		p_rects[i].x = x;
+		p_rects[i].y = y;
+		p_rects[i].w = Snap(left + m_halfW * 2) - x;
+		p_rects[i].h = Snap(top  + m_halfH * 2) - y;
+
+		left += m_halfW;
+		top  += m_halfH;
+	}
+}
+
+Vec2i Projection::TileAt(const Vec2f &p_pos) const {
+	// Inverse of TileRect, relative to the center of the tile diamond. Inside a diamond, both
+	// tile coordinates are within half a tile of the center
+	float a = (p_pos.x + offX - w / 2) / (w / 2);
+	float b = (p_pos.y + offY - h / 2) / (h / 2);
+
+	return Vec2i(static_cast<int32_t>(std::floor((b + a) / 2 + 0.5f)),
+	             static_cast<int32_t>(std::floor((b - a) / 2 + 0.5f)));
+}
+
+}
@@ -0,0 +1,50 @@
+#ifndef PROJECTION_HH__HEADER_GUARD__
+#define PROJECTION_HH__HEADER_GUARD__
+
+#include <cstdint> // std::int64_t, std::int32_t
+#include <cmath>   // std::llround, std::floor
+
+#include "../units.hh"
+#include "../main/config.hh"
+
+#include "camera.hh"
+#include "tile.hh"
+
+// Screen positions are stepped in fixed-point with this many fractional bits
+#define PROJECTION_FRAC_BITS 16
+#define PROJECTION_ONE       (static_cast<int64_t>(1) << PROJECTION_FRAC_BITS)
+
+namespace CityBuilder {
+
+// Where tiles end up on the screen for a camera. The tile steps are turned into fixed-point once,
+// so a row of tiles is just additions. Every tile corner is snapped from the same fixed-point
+// lattice, so the edges of neighbouring tiles always land on the same pixel, instead of each
+// rect rounding its position and size separately
+class Projection {
+public:
+	Projection(const Camera &p_camera);
+
+	Recti TileRect(int32_t p_x, int32_t p_y) const;
+	// Rects of the tiles (p_x, p_y), (p_x + 1, p_y), ... The tiles do not depend on each other,
+	// so the compiler can do several at once
+	void  RowRects(int32_t p_x, int32_t p_y, size_t p_count, Recti *p_rects) const;
+
+	// The tile under a screen position, may be outside of the world
+	Vec2i TileAt(const Vec2f &p_pos) const;
+
+	float w, h, offX, offY;
+
+private:
+	static int32_t Snap(int64_t p_fixed) {
+		// Rounds up, same as the float rects used to
+		return static_cast<int32_t>((p_fixed + PROJECTION_ONE - 1) >> PROJECTION_FRAC_BITS);
+	}
+
+	// Half of a tile size, screen movement for one step along the x or y tile axis
+	int64_t m_halfW, m_halfH;
+	int64_t m_offX, m_offY;
+};
+
+}
+
+#endif
@@ -0,0 +1,62 @@
+#include "simulation.hh"
+
+namespace CityBuilder {
+
+Simulation::Simulation(World &p_world):
+	m_world(p_world),
+
+	m_ticking(false),
+	m_stop(false),
+
+	m_thread(&Simulation::Run, this)
+{}
+
+Simulation::~Simulation() {
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+
+	m_cond.notify_all();
+	m_thread.join();
+}
+
+void Simulation::Kick() {
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_ticking = true;
+	}
+
+	m_cond.notify_all();
+}
+
+void Simulation::Wait() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_cond.wait(lock, [this]() {return not m_ticking;});
+}
+
+bool Simulation::WaitFor(size_t p_ms) {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return m_cond.wait_for(lock, std::chrono::milliseconds(p_ms), [this]() {return not m_ticking;});
+}
+
+void Simulation::Run() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	while (true) {
+		m_cond.wait(lock, [this]() {return m_ticking or m_stop;});
+
+		// A kicked tick still finishes, so whoever waits on it is not left hanging
+		if (m_ticking) {
+			lock.unlock();
+			m_world.Tick();
+			lock.lock();
+
+			m_ticking = false;
+			m_cond.notify_all();
+		} else
+			break;
+	}
+}
+
+}
@@ -0,0 +1,50 @@
+#ifndef SIMULATION_HH__HEADER_GUARD__
+#define SIMULATION_HH__HEADER_GUARD__
+
+#include <thread>             // std::thread
+#include <mutex>              // std::mutex, std::unique_lock
+#include <condition_variable> // std::condition_variable
+#include <chrono>             // std::chrono::milliseconds
+
+#include "../utils.hh"
+
+#include "world.hh"
+
+// How long the frame waits on a tick at most before it polls input again
+#define SIMULATION_POLL_MS 1
+
+namespace CityBuilder {
+
+// Runs World::Tick() on its own thread, in lockstep with the frames. A tick is kicked off at the
+// end of a frame update and runs while the next frame renders the snapshot of the tick before,
+// so the world is never read and written at the same time
+class Simulation {
+public:
+	Simulation(World &p_world);
+	~Simulation();
+
+	Simulation(Simulation &&p_sim)      = delete;
+	Simulation(const Simulation &p_sim) = delete;
+
+	void Kick();
+	// Blocks until the kicked tick is done, returns right away when none was kicked
+	void Wait();
+	// Returns whether the kicked tick is done, gives up waiting after p_ms
+	bool WaitFor(size_t p_ms);
+
+private:
+	void Run();
+
+	World &m_world;
+
+	std::mutex              m_mutex;
+	std::condition_variable m_cond;
+	bool                    m_ticking, m_stop;
+
+	// Last, so it starts after everything above is ready
+	std::thread m_thread;
+};
+
+}
+
+#endif
@@ -4,38 +4,468 @@
 
 namespace CityBuilder {
 
-World::World(const Vec2i &p_size): size(p_size) {
-	tiles.resize(p_size.y);
-	for (auto &row : tiles)
-		row.resize(p_size.x);
+World::Snapshot::Snapshot():
+	version(0)
+{}
 
+Tile::Type World::Snapshot::TileAt(int32_t p_x, int32_t p_y) const {
+	return tiles[static_cast<size_t>(p_y - region.y) * region.w + (p_x - region.x)];
+}
+
+World::World(const Vec2i &p_size):
+	m_version(0),
+	m_front(0),
+	m_visibleTiles(0)
+{
+	Resize(p_size);
+}
+
+void World::Resize(const Vec2i &p_size) {
+	size = p_size;
+
+	tiles.assign(p_size.y, Row(p_size.x));
+	buildings.clear();
+	m_journal.Clear();
+
+	camera       = Camera();
 	camera.pos.y = static_cast<float>(size.y) * TILE_H / 2;
+
+	m_chunks = Vec2i((size.x + WORLD_CHUNK_SIZE - 1) / WORLD_CHUNK_SIZE,
+	                 (size.y + WORLD_CHUNK_SIZE - 1) / WORLD_CHUNK_SIZE);
+
+	m_chunkDirty.assign(static_cast<size_t>(m_chunks.x) * m_chunks.y, false);
+	m_dirtyChunks.clear();
+
+	MarkDirty();
+
+	// Both, so there is something to render before the first tick
+	Publish(m_snapshots[0]);
+	Publish(m_snapshots[1]);
 }
 
 void World::Render() {
-	const float w = static_cast<float>(TILE_W) * camera.zoom;
-	const float h = static_cast<float>(TILE_H) * camera.zoom;
+	PROFILE_ZONE("World::Render");
+
+	const Snapshot &snapshot = Front();
+	Projection      projection(snapshot.camera);
+
+	m_visibleTiles = 0;
+
+	const Recti &region = snapshot.region;
+	m_rowRects.resize(region.w);
+
+	for (int32_t y = region.y; y < region.y + region.h; ++ y) {
+		projection.RowRects(region.x, y, region.w, m_rowRects.data());
+
+		for (int32_t i = 0; i < region.w; ++ i) {
+			const Recti &rect = m_rowRects[i];
+
+			// The region is only a bounding box of the screen, the corners are still off it
+			if (rect.x < SCREEN_W and rect.y < SCREEN_H and
+			    rect.x + rect.w > 0 and rect.y + rect.h > 0) {
+				Tile::ID id = static_cast<Tile::ID>(snapshot.TileAt(region.x + i, y));
+				Game::Get().tileSheet.Render(id, rect);
+
+				++ m_visibleTiles;
+			}
+		}
+	}
+}
+
+void World::Tick() {
+	PROFILE_ZONE("World::Tick");
+
+	ApplyCommands();
+	Publish(m_snapshots[m_front ^ 1]);
+}
+
+void World::ApplyCommands() {
+	Command command;
+	while (commands.Pop(command))
+		Apply(command);
+}
+
+void World::Apply(const Command &p_command) {
+	switch (p_command.type) {
+	case Command::Type::Build:
+		if (not Contains(p_command.tile))
+			break;
+
+		{
+			Tile &tile = tiles[p_command.tile.y][p_command.tile.x];
+			if (not tile.canPlaceOn or tile.type == p_command.tileType)
+				break;
+
+			Journal::State before = Journal::Pack(tile);
+			tile.type = p_command.tileType;
+
+			m_journal.Record(p_command.tile, before, Journal::Pack(tile));
+		}
+
+		MarkDirty(p_command.tile);
+		break;
+
+	case Command::Type::Demolish:
+		if (not Contains(p_command.tile))
+			break;
+
+		{
+			Tile &tile = tiles[p_command.tile.y][p_command.tile.x];
+
+			// Demolishing empty ground changes nothing, so it must not cost a redraw
+			Journal::State before = Journal::Pack(tile);
+			if (before == Journal::Pack(Tile()))
+				break;
+
+			tile = Tile();
+
+			m_journal.Record(p_command.tile, before, Journal::Pack(tile));
+		}
+
+		MarkDirty(p_command.tile);
+		break;
+
+	// Marked dirty once for the whole area, so caches get a single change to catch up on
+	case Command::Type::FillRect:
+		m_journal.Begin();
+		MarkDirty(FillRect(p_command.tile, p_command.to, p_command.tileType));
+		m_journal.End();
+
+		break;
+
+	case Command::Type::Line:
+		m_journal.Begin();
+		MarkDirty(Line(p_command.tile, p_command.to, p_command.tileType));
+		m_journal.End();
+
+		break;
+
+	case Command::Type::FloodFill:
+		m_journal.Begin();
+		MarkDirty(FloodFill(p_command.tile, p_command.tileType));
+		m_journal.End();
+
+		break;
+
+	case Command::Type::PanCamera:
+		switch (p_command.dir) {
+		case Dir::Up:    camera.Up();    break;
+		case Dir::Right: camera.Right(); break;
+		case Dir::Down:  camera.Down();  break;
+		case Dir::Left:  camera.Left();  break;
+		}
+
+		break;
+
+	case Command::Type::DragCamera: camera.Move(p_command.off); break;
+
+	case Command::Type::ZoomCamera:
+		for (int i = 0; i < p_command.steps; ++ i)
+			camera.ZoomIn();
+		for (int i = 0; i > p_command.steps; -- i)
+			camera.ZoomOut();
+
+		break;
+
+	case Command::Type::JumpCamera: camera.pos = p_command.pos; break;
+
+	case Command::Type::BeginEdit: m_journal.Begin(); break;
+	case Command::Type::EndEdit:   m_journal.End();   break;
+
+	case Command::Type::Undo: Restore(false); break;
+	case Command::Type::Redo: Restore(true);  break;
+
+	default: UNREACHABLE();
+	}
+}
+
+void World::SwapSnapshots() {
+	m_front ^= 1;
+}
+
+const World::Snapshot &World::Front() const {
+	return m_snapshots[m_front];
+}
+
+bool World::Contains(const Vec2i &p_tile) const {
+	return p_tile.x >= 0 and p_tile.y >= 0 and p_tile.x < size.x and p_tile.y < size.y;
+}
+
+size_t World::VisibleTiles() const {
+	return m_visibleTiles;
+}
+
+void World::MarkDirty() {
+	++ m_version;
+
+	for (int32_t y = 0; y < m_chunks.y; ++ y) {
+		for (int32_t x = 0; x < m_chunks.x; ++ x)
+			MarkChunkDirty(x, y);
+	}
+}
+
+void World::MarkDirty(const Vec2i &p_tile) {
+	++ m_version;
+
+	MarkChunkDirty(p_tile.x / WORLD_CHUNK_SIZE, p_tile.y / WORLD_CHUNK_SIZE);
+}
+
+void World::MarkDirty(const Recti &p_tiles) {
+	if (p_tiles.w <= 0 or p_tiles.h <= 0)
+		return;
 
-	const float offX = (camera.pos.x + TILE_W / 2) * camera.zoom - static_cast<float>(SCREEN_W) / 2;
-	const float offY = camera.pos.y * camera.zoom - static_cast<float>(SCREEN_H) / 2;
+	++ m_version;
 
-	float y = 0;
-	for (auto &row : tiles) {
-		float x = 0;
-		for (auto &tile : row) {
-			Rectf rect(x * (w / 2) + y * -(w / 2), x * (h / 2) + y *  (h / 2), w, h);
+	for (int32_t y = p_tiles.y / WORLD_CHUNK_SIZE;
+	     y <= (p_tiles.y + p_tiles.h - 1) / WORLD_CHUNK_SIZE; ++ y) {
+		for (int32_t x = p_tiles.x / WORLD_CHUNK_SIZE;
+		     x <= (p_tiles.x + p_tiles.w - 1) / WORLD_CHUNK_SIZE; ++ x)
+			MarkChunkDirty(x, y);
+	}
+}
+
+const TrackedVector<Vec2i, Memory::World> &World::DirtyChunks() const {
+	return m_dirtyChunks;
+}
+
+void World::ClearDirtyChunks() {
+	for (const auto &chunk : m_dirtyChunks)
+		m_chunkDirty[static_cast<size_t>(chunk.y) * m_chunks.x + chunk.x] = false;
+
+	m_dirtyChunks.clear();
+}
+
+Recti World::ChunkRect(const Vec2i &p_chunk) const {
+	Vec2i pos(p_chunk.x * WORLD_CHUNK_SIZE, p_chunk.y * WORLD_CHUNK_SIZE);
+
+	return Recti(pos.x, pos.y, std::min(WORLD_CHUNK_SIZE, size.x - pos.x),
+	             std::min(WORLD_CHUNK_SIZE, size.y - pos.y));
+}
+
+void World::MarkChunkDirty(int32_t p_x, int32_t p_y) {
+	uint8_t &dirty = m_chunkDirty[static_cast<size_t>(p_y) * m_chunks.x + p_x];
+	if (dirty)
+		return;
+
+	dirty = true;
+	m_dirtyChunks.push_back(Vec2i(p_x, p_y));
+}
+
+Recti World::FillRect(Vec2i p_from, Vec2i p_to, Tile::Type p_type) {
+	if (p_from.x > p_to.x)
+		std::swap(p_from.x, p_to.x);
+	if (p_from.y > p_to.y)
+		std::swap(p_from.y, p_to.y);
+
+	p_from.x = std::max(p_from.x, 0);
+	p_from.y = std::max(p_from.y, 0);
+	p_to.x   = std::min(p_to.x, size.x - 1);
+	p_to.y   = std::min(p_to.y, size.y - 1);
+
+	int32_t changed = 0;
+	for (int32_t y = p_from.y; y <= p_to.y; ++ y)
+		changed += FillSpan(p_from.x, y, p_to.x - p_from.x + 1, p_type);
+
+	if (changed == 0)
+		return Recti(0, 0, 0, 0);
+
+	return Recti(p_from.x, p_from.y, p_to.x - p_from.x + 1, p_to.y - p_from.y + 1);
+}
+
+Recti World::Line(const Vec2i &p_from, const Vec2i &p_to, Tile::Type p_type) {
+	Vec2i min(size.x, size.y), max(-1, -1);
+
+	// Bresenham, every tile of the line touches the previous one by a side or a corner
+	int32_t dx = std::abs(p_to.x - p_from.x), sx = p_from.x < p_to.x? 1 : -1;
+	int32_t dy = std::abs(p_to.y - p_from.y), sy = p_from.y < p_to.y? 1 : -1;
+	int32_t err = dx - dy;
+
+	Vec2i tile = p_from;
+	while (true) {
+		if (Contains(tile) and FillSpan(tile.x, tile.y, 1, p_type) > 0) {
+			min.x = std::min(min.x, tile.x);
+			min.y = std::min(min.y, tile.y);
+			max.x = std::max(max.x, tile.x);
+			max.y = std::max(max.y, tile.y);
+		}
+
+		if (tile.x == p_to.x and tile.y == p_to.y)
+			break;
+
+		int32_t err2 = err * 2;
+		if (err2 > -dy) {
+			err    -= dy;
+			tile.x += sx;
+		}
+		if (err2 < dx) {
+			err    += dx;
+			tile.y += sy;
+		}
+	}
+
+	if (max.x < min.x)
+		return Recti(0, 0, 0, 0);
+
+	return Recti(min.x, min.y, max.x - min.x + 1, max.y - min.y + 1);
+}
+
+Recti World::FloodFill(const Vec2i &p_tile, Tile::Type p_type) {
+	if (not Contains(p_tile))
+		return Recti(0, 0, 0, 0);
+
+	const Tile &seed = tiles[p_tile.y][p_tile.x];
+	if (not seed.canPlaceOn or seed.type == p_type)
+		return Recti(0, 0, 0, 0);
+
+	Tile::Type target = seed.type;
+	auto matches = [target](const Tile &p_tile) {
+		return p_tile.canPlaceOn and p_tile.type == target;
+	};
+
+	Vec2i min = p_tile, max = p_tile;
+
+	// Scanline, a whole span of the row gets filled at once and only the first tile of every
+	// matching span above and below it is pushed
+	m_floodStack.clear();
+	m_floodStack.push_back(p_tile);
 
-			rect.x -= offX;
-			rect.y -= offY;
+	while (not m_floodStack.empty()) {
+		Vec2i tile = m_floodStack.back();
+		m_floodStack.pop_back();
 
-			rect = rect.Ceil();
+		const Row &row = tiles[tile.y];
+		if (not matches(row[tile.x]))
+			continue;
 
-			Game::Get().tileSheet.Render(tile.GetID(), rect);
+		int32_t left = tile.x, right = tile.x;
+		while (left > 0 and matches(row[left - 1]))
+			-- left;
+		while (right < size.x - 1 and matches(row[right + 1]))
+			++ right;
 
-			++ x;
+		FillSpan(left, tile.y, right - left + 1, p_type);
+
+		min.x = std::min(min.x, left);
+		min.y = std::min(min.y, tile.y);
+		max.x = std::max(max.x, right);
+		max.y = std::max(max.y, tile.y);
+
+		for (int32_t y : {tile.y - 1, tile.y + 1}) {
+			if (y < 0 or y >= size.y)
+				continue;
+
+			const Row &next = tiles[y];
+			for (int32_t x = left; x <= right; ++ x) {
+				if (matches(next[x]) and (x == left or not matches(next[x - 1])))
+					m_floodStack.push_back(Vec2i(x, y));
+			}
 		}
+	}
+
+	return Recti(min.x, min.y, max.x - min.x + 1, max.y - min.y + 1);
+}
+
+int32_t World::FillSpan(int32_t p_x, int32_t p_y, int32_t p_count, Tile::Type p_type) {
+	Row &row = tiles[p_y];
+
+	int32_t changed = 0;
+	for (int32_t x = p_x; x < p_x + p_count; ++ x) {
+		Tile &tile = row[x];
+		if (not tile.canPlaceOn or tile.type == p_type)
+			continue;
+
+		Journal::State before = Journal::Pack(tile);
+		tile.type = p_type;
+
+		m_journal.Record(Vec2i(x, p_y), before, Journal::Pack(tile));
+		++ changed;
+	}
+
+	return changed;
+}
+
+void World::Restore(bool p_redo) {
+	Vec2i min(size.x, size.y), max(-1, -1);
+
+	auto restore = [this, &min, &max](const Journal::Run &p_run, Journal::State p_state) {
+		Row &row = tiles[p_run.y];
+		std::fill_n(row.begin() + p_run.x, p_run.count, Journal::Unpack(p_state));
+
+		min.x = std::min(min.x, p_run.x);
+		min.y = std::min(min.y, p_run.y);
+		max.x = std::max(max.x, p_run.x + static_cast<int32_t>(p_run.count) - 1);
+		max.y = std::max(max.y, p_run.y);
+	};
+
+	if (p_redo)
+		m_journal.Redo(restore);
+	else
+		m_journal.Undo(restore);
+
+	// Marked dirty once for the whole step, like the edit that made it
+	if (max.x >= min.x)
+		MarkDirty(Recti(min.x, min.y, max.x - min.x + 1, max.y - min.y + 1));
+}
+
+Recti World::VisibleRegion(const Camera &p_camera) const {
+	Projection projection(p_camera);
+
+	Vec2i corners[] = {
+		projection.TileAt(Vec2f(0, 0)),        projection.TileAt(Vec2f(SCREEN_W, 0)),
+		projection.TileAt(Vec2f(0, SCREEN_H)), projection.TileAt(Vec2f(SCREEN_W, SCREEN_H))
+	};
+
+	Vec2i min = corners[0], max = corners[0];
+	for (const auto &corner : corners) {
+		min.x = std::min(min.x, corner.x);
+		min.y = std::min(min.y, corner.y);
+		max.x = std::max(max.x, corner.x);
+		max.y = std::max(max.y, corner.y);
+	}
+
+	// A tile on the edge may be partly visible with its center picked as the neighbour
+	min.x = std::max(min.x - 1, 0);
+	min.y = std::max(min.y - 1, 0);
+	max.x = std::min(max.x + 1, size.x - 1);
+	max.y = std::min(max.y + 1, size.y - 1);
+
+	if (max.x < min.x or max.y < min.y)
+		return Recti(0, 0, 0, 0);
+
+	return Recti(min.x, min.y, max.x - min.x + 1, max.y - min.y + 1);
+}
+
+void World::Publish(Snapshot &p_snapshot) {
+	PROFILE_ZONE("World::Publish");
+
+	Recti region = VisibleRegion(camera);
+
+	p_snapshot.camera = camera;
+	p_snapshot.size   = size;
+
+	// This buffer was last filled two ticks ago, when nothing changed since, it is still good
+	if (p_snapshot.version == m_version and p_snapshot.region == region and
+	    p_snapshot.tiles.size() == static_cast<size_t>(region.w) * region.h)
+		return;
+
+	p_snapshot.version = m_version;
+	p_snapshot.region  = region;
+
+	p_snapshot.tiles.resize(static_cast<size_t>(region.w) * region.h);
+
+	auto out = p_snapshot.tiles.begin();
+	for (int32_t y = region.y; y < region.y + region.h; ++ y) {
+		const Row &row = tiles[y];
+
+		for (int32_t x = region.x; x < region.x + region.w; ++ x)
+			*out ++ = row[x].type;
+	}
 
-		++ y;
+	p_snapshot.buildings.clear();
+	for (const auto &building : buildings) {
+		if (building.pos.x >= region.x and building.pos.y >= region.y and
+		    building.pos.x < region.x + region.w and building.pos.y < region.y + region.h)
+			p_snapshot.buildings.push_back(building);
 	}
 }
 
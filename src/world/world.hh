@@ -1,28 +1,138 @@
 #ifndef WORLD_HH__HEADER_GUARD__
 #define WORLD_HH__HEADER_GUARD__
 
-#include <vector> // std::vector
-#include <cmath>  // std::ceil
+#include <vector>    // std::vector
+#include <cmath>     // std::ceil, std::floor
+#include <cstdlib>   // std::abs
+#include <utility>   // std::swap
+#include <algorithm> // std::min, std::max, std::fill_n
 
 #include "../units.hh"
+#include "../memory.hh"
+#include "../spsc_queue.hh"
 
 #include "camera.hh"
 #include "tile.hh"
 #include "building.hh"
+#include "command.hh"
+#include "projection.hh"
+#include "journal.hh"
+
+// Commands the simulation can get behind on in a single tick
+#define WORLD_COMMANDS_SIZE 1024
+
+// Changes are tracked per square chunk of tiles
+#define WORLD_CHUNK_SIZE 16
 
 namespace CityBuilder {
 
 class World {
 public:
+	// What the renderer gets to see of the world, copied at the end of every tick. Only the
+	// tiles that can be on the screen with the camera are copied
+	struct Snapshot {
+		Snapshot();
+
+		Tile::Type TileAt(int32_t p_x, int32_t p_y) const;
+
+		Camera camera;
+		Vec2i  size;
+		// Changes whenever any tile changes, not only the copied ones
+		size_t version;
+
+		Recti                                    region;
+		TrackedVector<Tile::Type, Memory::World> tiles; // Row-major, region.w * region.h
+		TrackedVector<Building,   Memory::World> buildings;
+	};
+
 	World(const Vec2i &p_size);
 
+	// Starts over with a flat grass world, the camera centered on it
+	void Resize(const Vec2i &p_size);
+
+	// Draws the front snapshot, never touches the simulation state
 	void Render();
 
+	// Applies the queued commands and publishes the back snapshot. The only part that runs on
+	// the simulation thread
+	void Tick();
+
+	// Simulation side of the command queue, applies everything queued up so far
+	void ApplyCommands();
+	void Apply(const Command &p_command);
+
+	// Only while the simulation is not ticking, makes the last published snapshot the front one
+	void SwapSnapshots();
+	const Snapshot &Front() const;
+
+	bool Contains(const Vec2i &p_tile) const;
+
+	// Of the last Render()
+	size_t VisibleTiles() const;
+
+	// Anything that changes how the world looks has to mark it dirty, so idle frames are not
+	// skipped over it, the snapshot tiles get copied again and caches built from the tiles
+	// (the minimap) update the chunk
+	void MarkDirty();
+	void MarkDirty(const Vec2i &p_tile);
+	void MarkDirty(const Recti &p_tiles);
+
+	// Chunks changed since the last ClearDirtyChunks(), each listed once. Only while the
+	// simulation is not ticking
+	const TrackedVector<Vec2i, Memory::World> &DirtyChunks() const;
+	void ClearDirtyChunks();
+
+	// Tiles of a chunk, the ones on the world edges may be smaller
+	Recti ChunkRect(const Vec2i &p_chunk) const;
+
+	// The simulation state, only touched by the simulation (or while it is not ticking)
 	Camera camera;
 	Vec2i  size;
 
-	std::vector<std::vector<Tile>> tiles;
-	std::vector<Building>          buildings;
+	using Row = TrackedVector<Tile, Memory::World>;
+
+	TrackedVector<Row,      Memory::World> tiles;
+	TrackedVector<Building, Memory::World> buildings;
+
+	// Filled by input, drained by the simulation
+	SPSCQueue<Command, WORLD_COMMANDS_SIZE> commands;
+
+private:
+	// The tiles around the screen for a camera, clamped to the world
+	Recti VisibleRegion(const Camera &p_camera) const;
+
+	void Publish(Snapshot &p_snapshot);
+
+	void MarkChunkDirty(int32_t p_x, int32_t p_y);
+
+	// Area edits only set the tiles and journal them, the caller marks the whole area dirty
+	// once. Each returns the tiles it changed, clamped to the world (empty if none changed)
+	Recti FillRect(Vec2i p_from, Vec2i p_to, Tile::Type p_type);
+	Recti Line(const Vec2i &p_from, const Vec2i &p_to, Tile::Type p_type);
+	Recti FloodFill(const Vec2i &p_tile, Tile::Type p_type);
+
+	// Sets the tiles [p_x, p_x + p_count) of a row that can be built on, returns how many changed
+	int32_t FillSpan(int32_t p_x, int32_t p_y, int32_t p_count, Tile::Type p_type);
+
+	// Undoes (or redoes) a journal step
+	void Restore(bool p_redo);
+
+	size_t m_version;
+
+	Journal m_journal;
+	// Spans waiting to be filled, kept around so flood fills do not allocate
+	TrackedVector<Vec2i, Memory::World> m_floodStack;
+
+	Vec2i                                 m_chunks;
+	TrackedVector<uint8_t, Memory::World> m_chunkDirty;
+	TrackedVector<Vec2i,   Memory::World> m_dirtyChunks;
+
+	Snapshot m_snapshots[2];
+	size_t   m_front;
+
+	// Render side
+	size_t                              m_visibleTiles;
+	TrackedVector<Recti, Memory::World> m_rowRects;
 };
 
 }